@@ -0,0 +1,116 @@
+//
+//  Forward kinematics throughput of N robots sharing one URDF:
+//  one `Chain::solve` per robot, the path each `Robot` takes on its
+//  own, against a single batched `Fleet::solve` with the scalar kernel
+//  and every SIMD kernel the CPU supports.
+//
+//  Usage: fleet_fk <urdf> [robots] [iterations]
+//
+#include "nexus/kinematics/chain.h"
+#include "nexus/kinematics/fleet.h"
+
+#include "urdf/model.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+GENERATE_LOG_FUNCTIONS(Benchmark)
+
+template <typename F>
+static double Seconds(std::size_t iterations, F &&f)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < iterations; ++i)
+        f();
+
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <urdf> [robots] [iterations]\n";
+        return EXIT_FAILURE;
+    }
+
+    const std::size_t robots = argc > 2 ? std::stoul(argv[2]) : 64;
+    const std::size_t iterations = argc > 3 ? std::stoul(argv[3]) : 1000;
+
+    urdf::Model model;
+
+    if (!model.initFile(argv[1]))
+    {
+        LOG_ERROR_Benchmark("Error parsing URDF at {}", argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    const Nexus::Chain chain(model);
+    const auto links = chain.links().size();
+    const auto joints = chain.joints().size();
+
+    std::mt19937 random(0);
+    std::uniform_real_distribution<double> angle(-3.0, 3.0);
+    std::vector<double> positions(robots * joints);
+
+    for (auto &q : positions)
+        q = angle(random);
+
+    // One GfMatrix4d product per link, robot after robot
+    std::vector<pxr::GfMatrix4d> poses(robots * links);
+
+    const double scalar = Seconds(iterations, [&]
+    {
+        for (std::size_t r = 0; r < robots; ++r)
+            chain.solve(&positions[r * joints], &poses[r * links]);
+    });
+
+    const double total = static_cast<double>(robots * links * iterations);
+
+    std::cout << robots << " robots x " << links << " links x " << iterations << " iterations\n"
+              << "  Chain::solve            " << total / scalar / 1e6 << " M link-poses/s\n";
+
+    // Every robot in one pass over structure-of-arrays lanes, once per kernel
+    for (auto kernel = Nexus::Fleet::Kernel::SCALAR; kernel <= Nexus::Fleet::Best();
+         kernel = static_cast<Nexus::Fleet::Kernel>(static_cast<int>(kernel) + 1))
+    {
+        Nexus::Fleet fleet(chain, robots, kernel);
+
+        const double batched = Seconds(iterations, [&]
+        {
+            for (std::size_t r = 0; r < robots; ++r)
+                fleet.set_positions(r, &positions[r * joints]);
+
+            fleet.solve();
+        });
+
+        double error = 0.0;
+
+        for (std::size_t r = 0; r < robots; ++r)
+        {
+            for (std::size_t l = 0; l < links; ++l)
+            {
+                const auto a = fleet.pose(r, l);
+                const auto &b = poses[r * links + l];
+
+                for (int i = 0; i < 4; ++i)
+                    for (int j = 0; j < 4; ++j)
+                        error = std::max(error, std::abs(a[i][j] - b[i][j]));
+            }
+        }
+
+        std::cout << std::format("  Fleet::solve {:<10} ", Nexus::Fleet::Name(kernel))
+                  << total / batched / 1e6 << " M link-poses/s, "
+                  << scalar / batched << "x, max difference " << error << "\n";
+    }
+
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,140 @@
+//
+//  Conversion throughput of decoded Assimp meshes into USD arrays:
+//  the per-element loops `MeshImport` used to run, against the bulk
+//  copy in `MeshImport::Convert`. Files are read once, outside the timing.
+//
+//  Usage: mesh_convert <mesh>... [--iterations N]
+//
+#include "nexus/convert/mesh_import.h"
+
+#include "assimp/Importer.hpp"
+#include "assimp/scene.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+GENERATE_LOG_FUNCTIONS(Benchmark)
+
+template <typename F>
+static double Seconds(std::size_t iterations, F &&f)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < iterations; ++i)
+        f();
+
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// One element at a time, assuming every face is a triangle
+static Nexus::MeshImport::Mesh Reference(const aiMesh &mesh)
+{
+    Nexus::MeshImport::Mesh result;
+    result.Points.resize(mesh.mNumVertices);
+    result.Normals.resize(mesh.HasNormals() ? mesh.mNumVertices : 0);
+    result.FaceVertexCounts.resize(mesh.mNumFaces);
+    result.FaceVertexIndices.resize(mesh.mNumFaces * 3);
+
+    for (unsigned int v = 0; v < result.Points.size(); v++)
+        result.Points[v] = pxr::GfVec3f(mesh.mVertices[v].x, mesh.mVertices[v].y, mesh.mVertices[v].z);
+
+    for (unsigned int v = 0; v < result.Normals.size(); v++)
+        result.Normals[v] = pxr::GfVec3f(mesh.mNormals[v].x, mesh.mNormals[v].y, mesh.mNormals[v].z);
+
+    for (unsigned int f = 0; f < mesh.mNumFaces; f++)
+    {
+        const aiFace &face = mesh.mFaces[f];
+        result.FaceVertexCounts[f] = face.mNumIndices;
+
+        for (unsigned int j = 0; j < face.mNumIndices; j++)
+            result.FaceVertexIndices[f * 3 + j] = face.mIndices[j];
+    }
+    return result;
+}
+
+int main(int argc, char **argv)
+{
+    std::vector<std::string> files;
+    std::size_t iterations = 100;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string argument = argv[i];
+
+        if (argument == "--iterations" && i + 1 < argc)
+            iterations = std::stoul(argv[++i]);
+        else
+            files.push_back(argument);
+    }
+
+    if (files.empty())
+    {
+        std::cerr << "Usage: " << argv[0] << " <mesh>... [--iterations N]\n";
+        return EXIT_FAILURE;
+    }
+
+    const Nexus::MeshImport::Options options;
+    std::vector<std::unique_ptr<Assimp::Importer>> importers;
+    std::vector<const aiMesh *> meshes;
+    std::size_t vertices = 0;
+
+    for (const auto &file : files)
+    {
+        auto &importer = importers.emplace_back(std::make_unique<Assimp::Importer>());
+        importer->SetPropertyFloat(AI_CONFIG_GLOBAL_SCALE_FACTOR_KEY, options.Scale);
+        const aiScene *scene = importer->ReadFile(file.c_str(), options.Flags);
+
+        if (scene == nullptr)
+        {
+            LOG_ERROR_Benchmark("Could not import mesh at {}: {}", file, importer->GetErrorString());
+            return EXIT_FAILURE;
+        }
+
+        for (unsigned int i = 0; i < scene->mNumMeshes; i++)
+        {
+            if (scene->mMeshes[i]->mPrimitiveTypes != aiPrimitiveType_TRIANGLE)
+                continue;
+
+            meshes.push_back(scene->mMeshes[i]);
+            vertices += scene->mMeshes[i]->mNumVertices;
+        }
+    }
+
+    std::vector<Nexus::MeshImport::Mesh> scalar(meshes.size());
+    std::vector<Nexus::MeshImport::Mesh> bulk(meshes.size());
+
+    const double before = Seconds(iterations, [&]
+    {
+        for (std::size_t m = 0; m < meshes.size(); ++m)
+            scalar[m] = Reference(*meshes[m]);
+    });
+
+    const double after = Seconds(iterations, [&]
+    {
+        for (std::size_t m = 0; m < meshes.size(); ++m)
+            bulk[m] = Nexus::MeshImport::Convert(*meshes[m]);
+    });
+
+    bool equal = true;
+
+    for (std::size_t m = 0; m < meshes.size(); ++m)
+    {
+        equal = equal && scalar[m].Points == bulk[m].Points && scalar[m].Normals == bulk[m].Normals &&
+                scalar[m].FaceVertexCounts == bulk[m].FaceVertexCounts &&
+                scalar[m].FaceVertexIndices == bulk[m].FaceVertexIndices;
+    }
+
+    const double total = static_cast<double>(vertices * iterations);
+
+    std::cout << meshes.size() << " meshes x " << vertices << " vertices x " << iterations << " iterations\n"
+              << "  Per element     " << total / before / 1e6 << " M vertices/s\n"
+              << "  Bulk            " << total / after / 1e6 << " M vertices/s\n"
+              << "  Speedup         " << before / after << "x\n"
+              << "  Identical       " << (equal ? "yes" : "no") << "\n";
+
+    return equal ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file
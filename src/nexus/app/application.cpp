@@ -20,12 +20,17 @@ Nexus::Application::Application(int argc, char **argv)
 
 Nexus::Application::~Application()
 {
+    World::StopRecording();
+    World::GetScheduler().stop();
+
     LOG_BASIC("Shutting down ROS...");
     rclcpp::shutdown();
 }
 
 void Nexus::Application::world_core()
 {
+    World::GetScheduler().start();
+
     m_Thread = std::jthread(
         [this]()
         {
@@ -54,6 +59,8 @@ void Nexus::Application::main_loop()
     {
         try
         {
+            World::Update();
+
             window.render_frame();
             window.handle_events();
 
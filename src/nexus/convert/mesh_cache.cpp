@@ -0,0 +1,365 @@
+#include "mesh_cache.h"
+
+#include "nexus/core/stage_queue.h"
+
+#include "pxr/base/tf/token.h"
+#include "pxr/usd/sdf/attributeSpec.h"
+#include "pxr/usd/sdf/layer.h"
+#include "pxr/usd/sdf/primSpec.h"
+#include "pxr/usd/sdf/variantSetSpec.h"
+#include "pxr/usd/sdf/variantSpec.h"
+#include "pxr/usd/usdGeom/tokens.h"
+#include "pxr/usd/usdUtils/dependencies.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+static constexpr std::uint64_t FNV_OFFSET = 0xcbf29ce484222325ull;
+static constexpr std::uint64_t FNV_PRIME = 0x100000001b3ull;
+
+static void Hash(std::uint64_t &hash, const char *data, std::size_t size)
+{
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= FNV_PRIME;
+    }
+}
+
+template <typename T>
+static void Hash(std::uint64_t &hash, const T &value)
+{
+    Hash(hash, reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+std::uint64_t Nexus::MeshCache::Key(const std::string &file, const MeshImport::Options &options)
+{
+    std::ifstream stream(file, std::ios::binary);
+
+    if (!stream)
+        return 0;
+
+    std::uint64_t hash = FNV_OFFSET;
+    char buffer[1 << 16];
+
+    while (stream.read(buffer, sizeof(buffer)) || stream.gcount() > 0)
+        Hash(hash, buffer, static_cast<std::size_t>(stream.gcount()));
+
+    Hash(hash, VERSION);
+    Hash(hash, std::bit_cast<std::uint32_t>(options.Scale));
+    Hash(hash, options.Flags);
+    Hash(hash, std::bit_cast<std::uint32_t>(options.Error));
+    Hash(hash, options.Optimize);
+    Hash(hash, options.Compact);
+    Hash(hash, std::bit_cast<std::uint32_t>(options.Angle));
+
+    for (const float fraction : options.Levels)
+        Hash(hash, std::bit_cast<std::uint32_t>(fraction));
+
+    return hash;
+}
+
+static std::size_t CountLevels(const Nexus::MeshImport::Node &node)
+{
+    std::size_t levels = 0;
+
+    for (const auto &mesh : node.Meshes)
+        levels = std::max(levels, mesh.Levels.size());
+
+    for (const auto &child : node.Children)
+        levels = std::max(levels, CountLevels(child));
+
+    return levels;
+}
+
+static std::uint64_t CountSaved(const Nexus::MeshImport::Node &node)
+{
+    std::uint64_t saved = 0;
+
+    for (const auto &mesh : node.Meshes)
+        saved += mesh.Saved;
+
+    for (const auto &child : node.Children)
+        saved += CountSaved(child);
+
+    return saved;
+}
+
+// Vertices kept and removed by `MeshImport::Optimize`, and cache misses before and after
+struct Optimized
+{
+    std::size_t Kept = 0;
+    std::size_t Removed = 0;
+    double Triangles = 0.0;
+    double Before = 0.0;
+    double After = 0.0;
+};
+
+static void CountOptimized(const Nexus::MeshImport::Node &node, Optimized &total)
+{
+    for (const auto &mesh : node.Meshes)
+    {
+        const double triangles = static_cast<double>(mesh.FaceVertexIndices.size() / 3);
+        total.Kept += mesh.Points.size();
+        total.Removed += mesh.Removed;
+        total.Triangles += triangles;
+        total.Before += mesh.Before * triangles;
+        total.After += mesh.After * triangles;
+    }
+
+    for (const auto &child : node.Children)
+        CountOptimized(child, total);
+}
+
+static std::uint64_t CountSaved(const Nexus::MeshImport::Result &result)
+{
+    std::uint64_t saved = 0;
+
+    for (const auto &node : result.Nodes)
+        saved += CountSaved(node);
+
+    return saved;
+}
+
+// Puts the triangles of `level` for every mesh below `parent`, taking
+// the full ones off `base` since local opinions are stronger than variants
+static void AuthorLevel(const Nexus::MeshImport::Node &node,
+                        const pxr::SdfLayerHandle &layer,
+                        const pxr::SdfPath &base,
+                        const pxr::SdfPrimSpecHandle &parent,
+                        std::size_t level)
+{
+    const auto nodePath = base.AppendChild(pxr::TfToken(node.Name));
+    const auto spec = pxr::SdfPrimSpec::New(parent, node.Name, pxr::SdfSpecifierOver);
+
+    for (const auto &mesh : node.Meshes)
+    {
+        const auto meshPath = nodePath.AppendChild(pxr::TfToken(mesh.Name));
+        const auto meshSpec = pxr::SdfPrimSpec::New(spec, mesh.Name, pxr::SdfSpecifierOver);
+        const auto &indices = level == 0 || mesh.Levels.empty()
+                                  ? mesh.FaceVertexIndices
+                                  : mesh.Levels[std::min(level, mesh.Levels.size()) - 1];
+
+        if (level == 0)
+        {
+            const auto full = layer->GetPrimAtPath(meshPath);
+            full->RemoveProperty(layer->GetPropertyAtPath(meshPath.AppendProperty(pxr::UsdGeomTokens->faceVertexCounts)));
+            full->RemoveProperty(layer->GetPropertyAtPath(meshPath.AppendProperty(pxr::UsdGeomTokens->faceVertexIndices)));
+        }
+
+        // Every face is a triangle after `MeshImport::Convert`
+        pxr::SdfAttributeSpec::New(meshSpec, pxr::UsdGeomTokens->faceVertexCounts, pxr::SdfValueTypeNames->IntArray)
+            ->SetDefaultValue(pxr::VtValue(pxr::VtIntArray(indices.size() / 3, 3)));
+        pxr::SdfAttributeSpec::New(meshSpec, pxr::UsdGeomTokens->faceVertexIndices, pxr::SdfValueTypeNames->IntArray)
+            ->SetDefaultValue(pxr::VtValue(indices));
+    }
+
+    for (const auto &child : node.Children)
+        AuthorLevel(child, layer, nodePath, spec, level);
+}
+
+bool Nexus::MeshCache::Write(const MeshImport::Result &result, const std::filesystem::path &path)
+{
+    const pxr::SdfPath root("/Mesh");
+    StageQueue queue;
+    queue.define(root, pxr::TfToken("Xform"));
+
+    for (const auto &node : result.Nodes)
+        MeshImport::Author(node, root, queue);
+
+    auto layer = pxr::SdfLayer::CreateAnonymous(".usdc");
+    queue.drain(layer);
+    layer->SetDefaultPrim(root.GetNameToken());
+
+    std::size_t levels = 0;
+
+    for (const auto &node : result.Nodes)
+        levels = std::max(levels, CountLevels(node));
+
+    if (levels > 0)
+    {
+        const auto prim = layer->GetPrimAtPath(root);
+        const auto set = pxr::SdfVariantSetSpec::New(prim, MeshImport::LEVEL_SET);
+
+        for (std::size_t level = 0; level <= levels; ++level)
+        {
+            const auto variant = pxr::SdfVariantSpec::New(set, MeshImport::LevelName(level));
+
+            for (const auto &node : result.Nodes)
+                AuthorLevel(node, layer, root, variant->GetPrimSpec(), level);
+        }
+        prim->GetVariantSetNameList().Prepend(MeshImport::LEVEL_SET);
+        prim->SetVariantSelection(MeshImport::LEVEL_SET, MeshImport::LevelName(0));
+    }
+    layer->SetComment(result.Path);
+
+    if (const auto saved = CountSaved(result); saved > 0)
+    {
+        auto data = layer->GetCustomLayerData();
+        data[SAVED] = pxr::VtValue(saved);
+        layer->SetCustomLayerData(data);
+    }
+
+    // Export beside the final name and rename, so readers never see half a file
+    auto temporary = path;
+    temporary.replace_extension(std::format("{}.usdc", std::hash<std::thread::id>{}(std::this_thread::get_id())));
+
+    if (!layer->Export(temporary.string()))
+    {
+        LOG_ERROR("Could not write {}", temporary.string());
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+
+    if (error)
+    {
+        LOG_ERROR("Could not move {} into the cache: {}", temporary.string(), error.message());
+        std::filesystem::remove(temporary, error);
+        return false;
+    }
+    return true;
+}
+
+auto Nexus::MeshCache::Resolve(const std::vector<std::string> &files, const MeshImport::Options &options)
+    -> std::vector<Resolved>
+{
+    using namespace std::chrono;
+    const auto start = steady_clock::now();
+
+    std::vector<Resolved> layers(files.size());
+    std::atomic<std::size_t> hits = 0;
+
+    const auto resolve = [&](std::size_t i)
+    {
+        const auto key = Key(files[i], options);
+
+        if (key == 0)
+        {
+            LOG_ALERT("Could not read {}", files[i]);
+            return;
+        }
+
+        const auto cached = Directory() / std::format("{:016x}.usdc", key);
+
+        if (std::filesystem::exists(cached))
+        {
+            layers[i].Path = cached.generic_string();
+            hits++;
+
+            // Only compacted layers have anything to report
+            if (!options.Compact)
+                return;
+
+            if (const auto layer = pxr::SdfLayer::FindOrOpen(layers[i].Path))
+            {
+                const auto data = layer->GetCustomLayerData();
+                const auto found = data.find(SAVED);
+
+                if (found != data.end() && found->second.IsHolding<std::uint64_t>())
+                    layers[i].Saved = found->second.UncheckedGet<std::uint64_t>();
+            }
+            return;
+        }
+
+        const auto result = MeshImport::Read(files[i], options);
+
+        if (!result.Valid)
+            return;
+
+        LOG_BASIC("Decoded {} in {:.1f} ms", files[i], result.Milliseconds);
+
+        if (options.Optimize)
+        {
+            Optimized total;
+
+            for (const auto &node : result.Nodes)
+                CountOptimized(node, total);
+
+            // Weighted by triangles, so the ratios are cache misses per triangle of the whole file
+            if (total.Triangles > 0.0)
+                LOG_BASIC("Optimized {}: {} -> {} vertices, ACMR {:.2f} -> {:.2f}",
+                          files[i], total.Kept + total.Removed, total.Kept,
+                          total.Before / total.Triangles, total.After / total.Triangles);
+        }
+
+        if (Write(result, cached))
+            layers[i] = {cached.generic_string(), CountSaved(result)};
+    };
+
+    MeshImport::Pool().run(files.size(), resolve);
+
+    const double total = duration<double, std::milli>(steady_clock::now() - start).count();
+    LOG_EVENT("Resolved {} meshes in {:.1f} ms, {} from cache", files.size(), total, hits.load());
+
+    return layers;
+}
+
+std::size_t Nexus::MeshCache::Localize(const pxr::SdfLayerHandle &layer, const std::filesystem::path &directory)
+{
+    const auto meshes = directory / "meshes";
+    std::size_t count = 0;
+
+    const auto localize = [&](const std::string &asset) -> std::string
+    {
+        const std::filesystem::path source(asset);
+
+        if (source.parent_path().lexically_normal() != Directory().lexically_normal())
+            return asset;
+
+        std::error_code error;
+        const auto target = meshes / source.filename();
+
+        // Names are content hashes, so a file already there is the same
+        if (!std::filesystem::exists(target, error))
+        {
+            std::filesystem::create_directories(meshes, error);
+            std::filesystem::copy_file(source, target, std::filesystem::copy_options::skip_existing, error);
+
+            if (error)
+            {
+                LOG_ALERT("Could not copy {} beside the stage: {}", asset, error.message());
+                return asset;
+            }
+        }
+        count++;
+        return "./meshes/" + source.filename().generic_string();
+    };
+
+    pxr::UsdUtilsModifyAssetPaths(layer, localize);
+    return count;
+}
+
+const std::filesystem::path &Nexus::MeshCache::Directory()
+{
+    static std::once_flag once;
+
+    const auto create = []
+    {
+        if (s_Directory.empty())
+        {
+            const char *variable = std::getenv("NEXUS_MESH_CACHE");
+            s_Directory = variable ? variable : std::filesystem::temp_directory_path() / "nexus" / "meshes";
+        }
+
+        std::error_code error;
+        std::filesystem::create_directories(s_Directory, error);
+    };
+
+    std::call_once(once, create);
+    return s_Directory;
+}
+
+void Nexus::MeshCache::SetDirectory(const std::filesystem::path &path)
+{
+    s_Directory = path;
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "mesh_import.h"
+
+#include "nexus/logging.h"
+
+#include "pxr/usd/sdf/layer.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Nexus
+{
+    ///
+    /// @brief A directory of meshes already converted to `.usdc`, named by a
+    /// hash of the source file content and the import options. Each layer
+    /// has a default prim holding the decoded nodes, ready to be referenced.
+    ///
+    class MeshCache : Logger<"Mesh Cache">
+    {
+    public:
+        struct Resolved
+        {
+            /* Cached layer, empty on failure */
+            std::string Path;
+
+            /* Bytes `MeshImport::Compact` saved in the layer */
+            std::uint64_t Saved = 0;
+        };
+
+        ///
+        /// @brief Convert mesh files that are not cached yet, in parallel
+        /// @param files Mesh files
+        /// @param options Scale and post-processing, part of the key
+        /// @return Cached layer of each file
+        ///
+        [[nodiscard]]
+        static std::vector<Resolved> Resolve(const std::vector<std::string> &files,
+                                             const MeshImport::Options &options = {});
+
+        ///
+        /// @brief Key of a file, zero if it cannot be read
+        ///
+        [[nodiscard]]
+        static std::uint64_t Key(const std::string &file, const MeshImport::Options &options);
+
+        ///
+        /// @brief Write decoded meshes to a layer with `/Mesh` as default prim,
+        /// and their levels of detail as variants of `/Mesh`. Bytes saved by
+        /// `MeshImport::Compact` go in the custom layer data as `SAVED`.
+        /// @return Whether the layer was written
+        ///
+        static bool Write(const MeshImport::Result &result, const std::filesystem::path &path);
+
+        ///
+        /// @brief Copy the cached layers `layer` references into `<directory>/meshes`
+        /// and make those references relative, so `layer` can be written to `directory`
+        /// and moved with that folder. Other asset paths are left alone.
+        /// @return Number of references rewritten
+        ///
+        static std::size_t Localize(const pxr::SdfLayerHandle &layer, const std::filesystem::path &directory);
+
+        /* `NEXUS_MESH_CACHE` if set, otherwise a folder in the temporary directory */
+        [[nodiscard]]
+        static const std::filesystem::path &Directory();
+
+        /* Overrides `Directory`, only before the first conversion */
+        static void SetDirectory(const std::filesystem::path &path);
+
+    public:
+        /* Bump when the layout of cached layers changes */
+        static constexpr std::uint64_t VERSION = 4;
+
+        /* Custom layer data holding the bytes saved by compaction */
+        static constexpr const char *SAVED = "nexusSavedBytes";
+
+    private:
+        static inline std::filesystem::path s_Directory;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,352 @@
+#include "mesh_import.h"
+
+#include "pxr/base/gf/range3f.h"
+#include "pxr/base/gf/vec3f.h"
+#include "pxr/base/tf/stringUtils.h"
+#include "pxr/base/tf/token.h"
+#include "pxr/usd/sdf/types.h"
+#include "pxr/usd/usdGeom/tokens.h"
+#include "pxr/usd/usdGeom/xformOp.h"
+
+#include "assimp/Importer.hpp"
+#include "assimp/postprocess.h"
+#include "assimp/scene.h"
+
+#include "meshoptimizer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <format>
+#include <numbers>
+#include <thread>
+#include <type_traits>
+
+static const pxr::TfToken XFORM("Xform", pxr::TfToken::Immortal);
+static const pxr::TfToken MESH("Mesh", pxr::TfToken::Immortal);
+
+const unsigned int Nexus::MeshImport::DEFAULT_FLAGS = aiProcess_CalcTangentSpace |
+                                                      aiProcess_Triangulate |
+                                                      aiProcess_JoinIdenticalVertices |
+                                                      aiProcess_SortByPType |
+                                                      aiProcess_GlobalScale;
+
+static_assert(std::is_same_v<ai_real, float> && sizeof(aiVector3D) == sizeof(pxr::GfVec3f),
+              "Vertices are copied in bulk, Assimp must use single precision");
+
+static void CopyVectors(pxr::VtArray<pxr::GfVec3f> &array, const aiVector3D *vectors, std::size_t count)
+{
+    // Skips the value-initialisation a plain `resize` would do first
+    array.resize(count,
+                 [vectors](pxr::GfVec3f *begin, pxr::GfVec3f *end)
+                 {
+                     std::memcpy(static_cast<void *>(begin), vectors, (end - begin) * sizeof(pxr::GfVec3f));
+                 });
+}
+
+static Nexus::MeshImport::Node ConvertNode(const aiScene *scene,
+                                           const aiNode *node,
+                                           const Nexus::MeshImport::Options &options)
+{
+    Nexus::MeshImport::Node result;
+    result.Name = pxr::TfMakeValidIdentifier(node->mName.C_Str());
+
+    const auto &m = node->mTransformation;
+    result.Transform = pxr::GfMatrix4d(m.a1, m.a2, m.a3, m.a4,
+                                       m.b1, m.b2, m.b3, m.b4,
+                                       m.c1, m.c2, m.c3, m.c4,
+                                       m.d1, m.d2, m.d3, m.d4);
+    result.Transform.Orthonormalize();
+
+    for (unsigned int i = 0; i < node->mNumMeshes; i++)
+    {
+        const aiMesh *mesh = scene->mMeshes[node->mMeshes[i]];
+
+        // Points and lines left by `aiProcess_SortByPType` have no surface to draw
+        if (!(mesh->mPrimitiveTypes & aiPrimitiveType_TRIANGLE))
+            continue;
+
+        auto &converted = result.Meshes.emplace_back(Nexus::MeshImport::Convert(*mesh));
+        Nexus::MeshImport::Optimize(converted, options);
+        Nexus::MeshImport::Simplify(converted, options);
+        Nexus::MeshImport::Compact(converted, options);
+    }
+
+    for (unsigned int i = 0; i < node->mNumChildren; i++)
+        result.Children.push_back(ConvertNode(scene, node->mChildren[i], options));
+
+    return result;
+}
+
+auto Nexus::MeshImport::Convert(const aiMesh &mesh) -> Mesh
+{
+    Mesh result;
+    result.Name = pxr::TfMakeValidIdentifier(mesh.mName.C_Str());
+
+    CopyVectors(result.Points, mesh.mVertices, mesh.mNumVertices);
+
+    if (mesh.HasNormals())
+        CopyVectors(result.Normals, mesh.mNormals, mesh.mNumVertices);
+
+    // After `aiProcess_Triangulate` a face is a triangle unless it is a point or a line
+    const auto isTriangle = [](const aiFace &face)
+    {
+        return face.mNumIndices == 3;
+    };
+
+    const std::size_t triangles = mesh.mPrimitiveTypes == aiPrimitiveType_TRIANGLE
+                                      ? mesh.mNumFaces
+                                      : std::count_if(mesh.mFaces, mesh.mFaces + mesh.mNumFaces, isTriangle);
+
+    result.FaceVertexCounts.assign(triangles, 3);
+
+    // Fixed-size copies the compiler can unroll, instead of a loop per face
+    const auto fillIndices = [&mesh, &isTriangle](int *out, int *)
+    {
+        for (unsigned int f = 0; f < mesh.mNumFaces; f++)
+        {
+            const aiFace &face = mesh.mFaces[f];
+
+            if (!isTriangle(face))
+                continue;
+
+            out[0] = static_cast<int>(face.mIndices[0]);
+            out[1] = static_cast<int>(face.mIndices[1]);
+            out[2] = static_cast<int>(face.mIndices[2]);
+            out += 3;
+        }
+    };
+
+    result.FaceVertexIndices.resize(triangles * 3, fillIndices);
+    return result;
+}
+
+void Nexus::MeshImport::Optimize(Mesh &mesh, const Options &options)
+{
+    static_assert(sizeof(int) == sizeof(unsigned int));
+
+    if (!options.Optimize || mesh.FaceVertexIndices.empty())
+        return;
+
+    // Cache size of the GPUs we target, only used to measure the ratio
+    constexpr unsigned int CACHE_SIZE = 16;
+
+    auto *indices = reinterpret_cast<unsigned int *>(mesh.FaceVertexIndices.data());
+    std::size_t count = mesh.FaceVertexIndices.size();
+    const std::size_t vertices = mesh.Points.size();
+    const auto before = meshopt_analyzeVertexCache(indices, count, vertices, CACHE_SIZE, 0, 0);
+
+    const auto isDegenerate = [indices](std::size_t i)
+    {
+        return indices[i] == indices[i + 1] || indices[i + 1] == indices[i + 2] || indices[i] == indices[i + 2];
+    };
+
+    std::size_t kept = 0;
+
+    for (std::size_t i = 0; i < count; i += 3)
+    {
+        if (isDegenerate(i))
+            continue;
+
+        std::copy_n(indices + i, 3, indices + kept);
+        kept += 3;
+    }
+    count = kept;
+
+    meshopt_optimizeVertexCache(indices, indices, count, vertices);
+    meshopt_optimizeOverdraw(indices, indices, count,
+                             reinterpret_cast<const float *>(mesh.Points.cdata()), vertices, sizeof(pxr::GfVec3f),
+                             1.05f);
+
+    // Vertices no triangle uses are left out of the remap
+    std::vector<unsigned int> remap(vertices);
+    const std::size_t unique = meshopt_optimizeVertexFetchRemap(remap.data(), indices, count, vertices);
+    meshopt_remapIndexBuffer(indices, indices, count, remap.data());
+
+    const auto remapVectors = [&remap, vertices, unique](pxr::VtArray<pxr::GfVec3f> &array)
+    {
+        if (array.size() != vertices)
+            return;
+
+        pxr::VtArray<pxr::GfVec3f> result(unique);
+        meshopt_remapVertexBuffer(result.data(), array.cdata(), vertices, sizeof(pxr::GfVec3f), remap.data());
+        array = std::move(result);
+    };
+
+    remapVectors(mesh.Points);
+    remapVectors(mesh.Normals);
+
+    const auto after = meshopt_analyzeVertexCache(indices, count, unique, CACHE_SIZE, 0, 0);
+    mesh.FaceVertexIndices.resize(count);
+    mesh.FaceVertexCounts.resize(count / 3);
+
+    // Summed per file by `MeshCache`, nothing is logged per mesh
+    mesh.Removed = vertices - unique;
+    mesh.Before = before.acmr;
+    mesh.After = after.acmr;
+}
+
+void Nexus::MeshImport::Simplify(Mesh &mesh, const Options &options)
+{
+    static_assert(sizeof(int) == sizeof(unsigned int));
+
+    const auto *indices = reinterpret_cast<const unsigned int *>(mesh.FaceVertexIndices.cdata());
+    const auto *positions = reinterpret_cast<const float *>(mesh.Points.cdata());
+    const std::size_t count = mesh.FaceVertexIndices.size();
+
+    mesh.Levels.clear();
+    mesh.Levels.reserve(options.Levels.size());
+
+    for (const float fraction : options.Levels)
+    {
+        // Each level starts from the full mesh so errors do not add up
+        const std::size_t target = static_cast<std::size_t>(count / 3 * fraction) * 3;
+        auto &level = mesh.Levels.emplace_back(count);
+
+        const std::size_t size = meshopt_simplify(reinterpret_cast<unsigned int *>(level.data()),
+                                                  indices, count,
+                                                  positions, mesh.Points.size(), sizeof(pxr::GfVec3f),
+                                                  target, options.Error, 0, nullptr);
+        level.resize(size);
+
+        // Simplification keeps the vertex order but not the triangle order
+        if (options.Optimize)
+            meshopt_optimizeVertexCache(reinterpret_cast<unsigned int *>(level.data()),
+                                        reinterpret_cast<const unsigned int *>(level.cdata()),
+                                        size, mesh.Points.size());
+    }
+}
+
+void Nexus::MeshImport::Compact(Mesh &mesh, const Options &options)
+{
+    if (!options.Compact || mesh.Normals.size() != mesh.Points.size())
+        return;
+
+    // Same as Hydra, the cross product of each triangle added to its corners
+    std::vector<pxr::GfVec3f> smooth(mesh.Points.size(), pxr::GfVec3f(0.0f));
+    const auto *points = mesh.Points.cdata();
+    const auto *normals = mesh.Normals.cdata();
+    const auto *indices = mesh.FaceVertexIndices.cdata();
+
+    for (std::size_t i = 0; i + 2 < mesh.FaceVertexIndices.size(); i += 3)
+    {
+        const auto &a = points[indices[i]];
+        const auto &b = points[indices[i + 1]];
+        const auto &c = points[indices[i + 2]];
+        const auto normal = pxr::GfCross(b - a, c - a);
+
+        smooth[indices[i]] += normal;
+        smooth[indices[i + 1]] += normal;
+        smooth[indices[i + 2]] += normal;
+    }
+
+    const float cosine = std::cos(options.Angle * std::numbers::pi_v<float> / 180.0f);
+
+    for (std::size_t i = 0; i < smooth.size(); ++i)
+    {
+        // Assimp keeps corners with different normals apart, so a hard edge is only
+        // smooth on each side and dropping normals loses nothing unless one differs
+        if (smooth[i].GetLength() > 0.0f &&
+            pxr::GfDot(smooth[i].GetNormalized(), normals[i].GetNormalized()) < cosine)
+            return;
+    }
+
+    mesh.Saved += mesh.Normals.size() * sizeof(pxr::GfVec3f);
+    mesh.Normals = {};
+}
+
+std::string Nexus::MeshImport::LevelName(std::size_t level)
+{
+    return std::format("lod{}", level);
+}
+
+auto Nexus::MeshImport::Read(const std::string &path, const Options &options) -> Result
+{
+    using namespace std::chrono;
+    const auto start = steady_clock::now();
+
+    Result result;
+    result.Path = path;
+
+    Assimp::Importer importer;
+    importer.SetPropertyFloat(AI_CONFIG_GLOBAL_SCALE_FACTOR_KEY, options.Scale);
+
+    const aiScene *scene = importer.ReadFile(path.c_str(), options.Flags);
+
+    if (scene == nullptr)
+    {
+        LOG_ALERT("Could not import mesh at {}: {}", path, importer.GetErrorString());
+        return result;
+    }
+
+    if (scene->mNumMeshes == 0)
+    {
+        LOG_ALERT("Mesh at {} was empty", path);
+        return result;
+    }
+
+    for (unsigned int i = 0; i < scene->mRootNode->mNumChildren; i++)
+    {
+        const aiNode *child = scene->mRootNode->mChildren[i];
+
+        if (child->mNumMeshes > 0)
+            result.Nodes.push_back(ConvertNode(scene, child, options));
+    }
+
+    result.Valid = true;
+    result.Milliseconds = duration<double, std::milli>(steady_clock::now() - start).count();
+    return result;
+}
+
+void Nexus::MeshImport::Author(const Node &node, const pxr::SdfPath &parent, StageQueue &queue)
+{
+    const auto nodePath = parent.AppendChild(pxr::TfToken(node.Name));
+    const auto transform = pxr::UsdGeomXformOp::GetOpName(pxr::UsdGeomXformOp::TypeTransform);
+
+    queue.define(nodePath, XFORM);
+    queue.create(nodePath.AppendProperty(transform),
+                 pxr::SdfValueTypeNames->Matrix4d,
+                 pxr::VtValue(node.Transform));
+    queue.create(nodePath.AppendProperty(pxr::UsdGeomTokens->xformOpOrder),
+                 pxr::SdfValueTypeNames->TokenArray,
+                 pxr::VtValue(pxr::VtTokenArray{transform}),
+                 pxr::SdfVariabilityUniform);
+
+    for (const auto &mesh : node.Meshes)
+    {
+        const auto meshPath = nodePath.AppendChild(pxr::TfToken(mesh.Name));
+        queue.define(meshPath, MESH);
+        queue.create(meshPath.AppendProperty(pxr::UsdGeomTokens->points),
+                     pxr::SdfValueTypeNames->Point3fArray, pxr::VtValue(mesh.Points));
+
+        // Saves every bounds query from reading the points
+        pxr::GfRange3f range;
+
+        for (const auto &point : mesh.Points)
+            range.UnionWith(point);
+
+        queue.create(meshPath.AppendProperty(pxr::UsdGeomTokens->extent),
+                     pxr::SdfValueTypeNames->Float3Array,
+                     pxr::VtValue(pxr::VtVec3fArray{range.GetMin(), range.GetMax()}));
+
+        if (!mesh.Normals.empty())
+            queue.create(meshPath.AppendProperty(pxr::UsdGeomTokens->normals),
+                         pxr::SdfValueTypeNames->Normal3fArray, pxr::VtValue(mesh.Normals));
+
+        queue.create(meshPath.AppendProperty(pxr::UsdGeomTokens->faceVertexCounts),
+                     pxr::SdfValueTypeNames->IntArray, pxr::VtValue(mesh.FaceVertexCounts));
+        queue.create(meshPath.AppendProperty(pxr::UsdGeomTokens->faceVertexIndices),
+                     pxr::SdfValueTypeNames->IntArray, pxr::VtValue(mesh.FaceVertexIndices));
+    }
+
+    for (const auto &child : node.Children)
+        Author(child, nodePath, queue);
+}
+
+Nexus::ThreadPool &Nexus::MeshImport::Pool()
+{
+    // Decoding is CPU bound and the caller takes part, so one thread per core
+    static ThreadPool pool(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+    return pool;
+}
\ No newline at end of file
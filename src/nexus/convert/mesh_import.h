@@ -0,0 +1,151 @@
+#pragma once
+
+#include "nexus/core/stage_queue.h"
+#include "nexus/core/thread_pool.h"
+#include "nexus/logging.h"
+
+#include "pxr/base/gf/matrix4d.h"
+#include "pxr/base/gf/vec3f.h"
+#include "pxr/base/vt/array.h"
+#include "pxr/usd/sdf/path.h"
+
+#include <string>
+#include <vector>
+
+struct aiMesh;
+
+namespace Nexus
+{
+    ///
+    /// @brief Decodes mesh files with Assimp into plain USD-ready arrays.
+    /// Decoding does not touch any layer, so many files can be read in
+    /// parallel and only `Author` needs to run in order.
+    ///
+    class MeshImport : Logger<"Mesh Import">
+    {
+    public:
+        struct Options
+        {
+            /* Applied with `aiProcess_GlobalScale`, URDF meshes are usually in millimetres */
+            float Scale = 0.001f;
+
+            /* `aiPostProcessSteps` run after reading */
+            unsigned int Flags = DEFAULT_FLAGS;
+
+            /* Fraction of triangles kept by each coarser level of detail */
+            std::vector<float> Levels = {0.25f, 0.05f};
+
+            /* Largest simplification error relative to the mesh size */
+            float Error = 0.05f;
+
+            /* Reorder triangles and vertices for the GPU, see `Optimize` */
+            bool Optimize = true;
+
+            /* Drop normals that match the smooth normals Hydra computes anyway */
+            bool Compact = false;
+
+            /* Largest difference in degrees for a normal to count as smooth */
+            float Angle = 1.0f;
+        };
+
+        struct Mesh
+        {
+            std::string Name;
+            pxr::VtArray<pxr::GfVec3f> Points;
+            pxr::VtArray<pxr::GfVec3f> Normals;
+            pxr::VtArray<int> FaceVertexCounts;
+            pxr::VtArray<int> FaceVertexIndices;
+
+            /* Triangle indices of each coarser level, into the same `Points` */
+            std::vector<pxr::VtArray<int>> Levels;
+
+            /* Bytes `Compact` saved on normals */
+            std::size_t Saved = 0;
+
+            /* Vertices `Optimize` removed, and the average cache miss ratio before and after */
+            std::size_t Removed = 0;
+            float Before = 0.0f;
+            float After = 0.0f;
+        };
+
+        struct Node
+        {
+            std::string Name;
+            pxr::GfMatrix4d Transform = pxr::GfMatrix4d(1);
+            std::vector<Mesh> Meshes;
+            std::vector<Node> Children;
+        };
+
+        struct Result
+        {
+            std::string Path;
+
+            /* Top-level nodes that hold meshes */
+            std::vector<Node> Nodes;
+
+            /* Time spent reading and converting */
+            double Milliseconds = 0.0;
+
+            bool Valid = false;
+        };
+
+        static const unsigned int DEFAULT_FLAGS;
+
+        /* Variant set holding the levels of detail, named by `LevelName` */
+        static inline const std::string LEVEL_SET = "lod";
+
+    public:
+        ///
+        /// @brief Decode one file, safe to call from any thread
+        /// @param path Mesh file
+        /// @param options Scale and post-processing
+        ///
+        [[nodiscard]]
+        static Result Read(const std::string &path, const Options &options = {});
+
+        ///
+        /// @brief Copy the triangles of an Assimp mesh into USD arrays in bulk
+        /// @param mesh Mesh of a scene read with `aiProcess_Triangulate`
+        ///
+        [[nodiscard]]
+        static Mesh Convert(const aiMesh &mesh);
+
+        ///
+        /// @brief Drop degenerate triangles and unused vertices, then reorder triangles
+        /// for the post-transform cache and overdraw, and vertices for fetch locality
+        /// @param mesh Converted mesh without levels of detail yet
+        /// @param options Does nothing unless `Optimize` is set
+        ///
+        static void Optimize(Mesh &mesh, const Options &options);
+
+        ///
+        /// @brief Simplify a mesh into one index array per level of `options`
+        /// @param mesh Converted mesh, `Levels` is replaced
+        /// @param options Fractions and error bound
+        ///
+        static void Simplify(Mesh &mesh, const Options &options);
+
+        ///
+        /// @brief Drop the normals of a mesh if every one is within `Angle` of the
+        /// area-weighted smooth normal, so authored hard edges are kept
+        /// @param mesh Converted mesh
+        /// @param options Does nothing unless `Compact` is set
+        ///
+        static void Compact(Mesh &mesh, const Options &options);
+
+        /* "lod0" is the full mesh */
+        [[nodiscard]]
+        static std::string LevelName(std::size_t level);
+
+        ///
+        /// @brief Queue the prims of a decoded node under `parent`
+        /// @param node Decoded node
+        /// @param parent Path of the parent prim
+        /// @param queue Destination of the edits
+        ///
+        static void Author(const Node &node, const pxr::SdfPath &parent, StageQueue &queue);
+
+        /* Shared by every conversion step that runs per file */
+        static ThreadPool &Pool();
+    };
+}
\ No newline at end of file
@@ -0,0 +1,271 @@
+#include "urdf_import.h"
+
+#include "mesh_cache.h"
+
+#include "pxr/base/gf/quatf.h"
+#include "pxr/base/gf/vec3d.h"
+#include "pxr/base/gf/vec3f.h"
+#include "pxr/base/tf/stringUtils.h"
+#include "pxr/base/vt/array.h"
+#include "pxr/usd/sdf/types.h"
+#include "pxr/usd/usdGeom/tokens.h"
+#include "pxr/usd/usdGeom/xformOp.h"
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <vector>
+
+static const pxr::TfToken XFORM("Xform", pxr::TfToken::Immortal);
+static const pxr::TfToken CUBE("Cube", pxr::TfToken::Immortal);
+static const pxr::TfToken CYLINDER("Cylinder", pxr::TfToken::Immortal);
+static const pxr::TfToken SPHERE("Sphere", pxr::TfToken::Immortal);
+static const pxr::TfToken VISUAL("visual", pxr::TfToken::Immortal);
+static const pxr::TfToken COLLISION("collision", pxr::TfToken::Immortal);
+
+static auto OpPath(const pxr::SdfPath &path, pxr::UsdGeomXformOp::Type type)
+{
+    return path.AppendProperty(pxr::UsdGeomXformOp::GetOpName(type));
+}
+
+auto Nexus::UrdfImport::GetPrototype(const std::string &path, std::shared_ptr<const urdf::ModelInterface> model)
+    -> Prototype
+{
+    std::error_code error;
+    const auto time = std::filesystem::last_write_time(path, error);
+
+    std::lock_guard guard(s_Mutex);
+    auto &entry = s_Prototypes[path];
+
+    if (entry.Value.Layer.valid() && entry.Time == time && entry.Compact == OPTIONS.Compact)
+        return entry.Value;
+
+    LOG_BASIC("Building prototype of {}", path);
+    const pxr::SdfPath root('/' + pxr::TfMakeValidIdentifier(model->name_));
+
+    const auto build = [model, root, options = OPTIONS]
+    {
+        return Build(*model, root, options);
+    };
+
+    entry = {time, OPTIONS.Compact, {root, std::async(std::launch::async, build).share()}};
+    return entry.Value;
+}
+
+bool Nexus::UrdfImport::HasGeometry(const urdf::Link &link)
+{
+    return (link.visual && link.visual->geometry) || (link.collision && link.collision->geometry);
+}
+
+pxr::SdfPath Nexus::UrdfImport::PosePath(const pxr::SdfPath &root, const std::string &link)
+{
+    return OpPath(root.AppendChild(pxr::TfToken(link)), pxr::UsdGeomXformOp::TypeTransform);
+}
+
+pxr::SdfLayerRefPtr Nexus::UrdfImport::Build(const urdf::ModelInterface &model,
+                                             const pxr::SdfPath &root,
+                                             const MeshImport::Options &options)
+{
+    // Convert every mesh up front in parallel, authoring below stays in order
+    std::vector<std::string> visuals;
+    std::vector<std::string> collisions;
+
+    const auto collect = [](std::vector<std::string> &files, const urdf::GeometrySharedPtr &geometry)
+    {
+        if (!geometry || geometry->type != urdf::Geometry::MESH)
+            return;
+
+        const auto &filename = std::static_pointer_cast<urdf::Mesh>(geometry)->filename;
+
+        if (std::ranges::find(files, filename) == files.end())
+            files.push_back(filename);
+    };
+
+    for (const auto &[name, link] : model.links_)
+    {
+        if (link && link->visual)
+            collect(visuals, link->visual->geometry);
+
+        if (link && link->collision)
+            collect(collisions, link->collision->geometry);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    std::uint64_t saved = 0;
+
+    const auto resolve = [&saved](const std::vector<std::string> &files, const MeshImport::Options &options)
+    {
+        const auto resolved = MeshCache::Resolve(files, options);
+        Layers layers;
+
+        for (std::size_t i = 0; i < files.size(); ++i)
+        {
+            layers[files[i]] = resolved[i].Path;
+            saved += resolved[i].Saved;
+        }
+
+        return layers;
+    };
+
+    // Collision meshes are already coarse, so they get no levels of detail
+    auto coarse = options;
+    coarse.Levels.clear();
+
+    const auto visualLayers = resolve(visuals, options);
+    const auto collisionLayers = resolve(collisions, coarse);
+
+    StageQueue queue;
+    queue.define(root, XFORM);
+
+    for (const auto &[name, link] : model.links_)
+    {
+        const pxr::SdfPath linkPath = root.AppendChild(pxr::TfToken(name));
+        queue.define(linkPath, XFORM);
+
+        LOG_BASIC("Got link '{}'", name);
+
+        if (!link)
+        {
+            LOG_BASIC("Link was null... skipping");
+            continue;
+        }
+
+        if (!HasGeometry(*link))
+        {
+            LOG_BASIC("Geometry was null... skipping");
+            continue;
+        }
+
+        queue.create(PosePath(root, name), pxr::SdfValueTypeNames->Matrix4d);
+        queue.create(linkPath.AppendProperty(pxr::UsdGeomTokens->xformOpOrder),
+                     pxr::SdfValueTypeNames->TokenArray,
+                     pxr::VtValue(pxr::VtTokenArray{
+                         pxr::UsdGeomXformOp::GetOpName(pxr::UsdGeomXformOp::TypeTransform)}),
+                     pxr::SdfVariabilityUniform);
+
+        if (link->visual && link->visual->geometry)
+            Author(queue, linkPath.AppendChild(VISUAL), link->visual->origin, link->visual->geometry,
+                   link->visual->material, pxr::UsdGeomTokens->render, visualLayers);
+
+        if (link->collision && link->collision->geometry)
+            Author(queue, linkPath.AppendChild(COLLISION), link->collision->origin, link->collision->geometry,
+                   nullptr, pxr::UsdGeomTokens->proxy, collisionLayers);
+    }
+
+    auto layer = pxr::SdfLayer::CreateAnonymous(".usda");
+    queue.drain(layer);
+
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    LOG_EVENT("Converted URDF to USD with {} links in {:.1f} ms", model.links_.size(), elapsed.count());
+
+    if (saved > 0)
+        LOG_EVENT("Compact meshes of '{}' saved {:.2f} MB", model.name_, saved / 1e6);
+    return layer;
+}
+
+void Nexus::UrdfImport::Author(StageQueue &queue,
+                               const pxr::SdfPath &path,
+                               const urdf::Pose &origin,
+                               const urdf::GeometrySharedPtr &geometry,
+                               const urdf::MaterialSharedPtr &material,
+                               const pxr::TfToken &purpose,
+                               const Layers &layers)
+{
+    // Primitives are native gprims sized by a scale op, Hydra tessellates them
+    pxr::TfToken schema = XFORM;
+    std::optional<pxr::GfVec3f> scale;
+
+    switch (geometry->type)
+    {
+    case urdf::Geometry::BOX:
+    {
+        // The default cube has sides of 2
+        const auto &box = std::static_pointer_cast<urdf::Box>(geometry)->dim;
+        schema = CUBE;
+        scale = pxr::GfVec3f(box.x, box.y, box.z) / 2.0f;
+        break;
+    }
+    case urdf::Geometry::CYLINDER:
+    {
+        // The default cylinder has a radius of 1 and a height of 2 along Z
+        const auto &cylinder = std::static_pointer_cast<urdf::Cylinder>(geometry);
+        schema = CYLINDER;
+        scale = pxr::GfVec3f(cylinder->radius, cylinder->radius, cylinder->length / 2.0);
+        break;
+    }
+    case urdf::Geometry::SPHERE:
+    {
+        // The default sphere has a radius of 1
+        const auto radius = std::static_pointer_cast<urdf::Sphere>(geometry)->radius;
+        schema = SPHERE;
+        scale = pxr::GfVec3f(radius);
+        break;
+    }
+    case urdf::Geometry::MESH:
+        break;
+    default:
+        LOG_ERROR("Unknown geometry type!");
+        return;
+    }
+
+    /* Origin goes on the child so it applies inside the link pose */
+    pxr::VtTokenArray order = {pxr::UsdGeomXformOp::GetOpName(pxr::UsdGeomXformOp::TypeTranslate),
+                               pxr::UsdGeomXformOp::GetOpName(pxr::UsdGeomXformOp::TypeOrient)};
+
+    queue.define(path, schema);
+    queue.create(path.AppendProperty(pxr::UsdGeomTokens->purpose),
+                 pxr::SdfValueTypeNames->Token,
+                 pxr::VtValue(purpose),
+                 pxr::SdfVariabilityUniform);
+    queue.create(OpPath(path, pxr::UsdGeomXformOp::TypeTranslate),
+                 pxr::SdfValueTypeNames->Double3,
+                 pxr::VtValue(pxr::GfVec3d(origin.position.x,
+                                           origin.position.y,
+                                           origin.position.z)));
+    queue.create(OpPath(path, pxr::UsdGeomXformOp::TypeOrient),
+                 pxr::SdfValueTypeNames->Quatf,
+                 pxr::VtValue(pxr::GfQuatf(origin.rotation.w,
+                                           origin.rotation.x,
+                                           origin.rotation.y,
+                                           origin.rotation.z)));
+
+    if (scale)
+    {
+        queue.create(OpPath(path, pxr::UsdGeomXformOp::TypeScale),
+                     pxr::SdfValueTypeNames->Float3,
+                     pxr::VtValue(*scale));
+        order.push_back(pxr::UsdGeomXformOp::GetOpName(pxr::UsdGeomXformOp::TypeScale));
+    }
+
+    queue.create(path.AppendProperty(pxr::UsdGeomTokens->xformOpOrder),
+                 pxr::SdfValueTypeNames->TokenArray,
+                 pxr::VtValue(order),
+                 pxr::SdfVariabilityUniform);
+
+    if (material && geometry->type != urdf::Geometry::MESH)
+    {
+        const auto &color = material->color;
+        queue.create(path.AppendProperty(pxr::UsdGeomTokens->primvarsDisplayColor),
+                     pxr::SdfValueTypeNames->Color3fArray,
+                     pxr::VtValue(pxr::VtVec3fArray{pxr::GfVec3f(color.r, color.g, color.b)}));
+
+        if (color.a < 1.0f)
+            queue.create(path.AppendProperty(pxr::UsdGeomTokens->primvarsDisplayOpacity),
+                         pxr::SdfValueTypeNames->FloatArray,
+                         pxr::VtValue(pxr::VtFloatArray{color.a}));
+    }
+
+    if (geometry->type != urdf::Geometry::MESH)
+        return;
+
+    const auto &filename = std::static_pointer_cast<urdf::Mesh>(geometry)->filename;
+    const auto found = layers.find(filename);
+
+    if (found == layers.end() || found->second.empty())
+    {
+        LOG_ALERT("Could not convert mesh at {}", filename);
+        return;
+    }
+    queue.reference(path, found->second, true);
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "mesh_import.h"
+
+#include "nexus/core/stage_queue.h"
+#include "nexus/logging.h"
+
+#include "pxr/base/tf/token.h"
+#include "pxr/usd/sdf/layer.h"
+#include "pxr/usd/sdf/path.h"
+
+#include "urdf_model/model.h"
+
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace Nexus
+{
+    ///
+    /// @brief Converts a parsed URDF into prims. Each link becomes an Xform
+    /// posed by one transform op. Its visual and collision geometry become
+    /// `visual` and `collision` children with render and proxy purpose.
+    /// Mesh children are instanceable, so Hydra shares one copy of each
+    /// mesh across every robot that uses it.
+    /// Nothing here needs a stage or a node, so robots and tools share it.
+    ///
+    class UrdfImport : Logger<"URDF Import">
+    {
+    public:
+        /* Converted layer of each mesh file */
+        using Layers = std::unordered_map<std::string, std::string>;
+
+        /* Layer built once per URDF and copied by every robot made from it */
+        struct Prototype
+        {
+            /* Root prim in `Layer` */
+            pxr::SdfPath Path;
+            std::shared_future<pxr::SdfLayerRefPtr> Layer;
+        };
+
+        ///
+        /// @brief Author every link of `model` under `root` into a new anonymous layer.
+        /// Meshes are converted through `MeshCache`, safe to call from any thread.
+        /// @param model Parsed URDF
+        /// @param root Prim of the robot
+        /// @param options Import of visual meshes, collision meshes skip the levels of detail
+        ///
+        [[nodiscard]]
+        static pxr::SdfLayerRefPtr Build(const urdf::ModelInterface &model,
+                                         const pxr::SdfPath &root,
+                                         const MeshImport::Options &options = {});
+
+        ///
+        /// @brief Prototype of a URDF, built on a worker thread the first time
+        /// it is asked for and again whenever the file or `OPTIONS` change
+        /// @param path URDF file, the key of the registry
+        /// @param model Parsed `path`, used if a build is needed
+        ///
+        [[nodiscard]]
+        static Prototype GetPrototype(const std::string &path, std::shared_ptr<const urdf::ModelInterface> model);
+
+        /* Whether a link has geometry, and so a transform op to pose */
+        [[nodiscard]]
+        static bool HasGeometry(const urdf::Link &link);
+
+        /* Path of the transform op that poses a link */
+        [[nodiscard]]
+        static pxr::SdfPath PosePath(const pxr::SdfPath &root, const std::string &link);
+
+    public:
+        /* Mesh import of prototypes, read on the main thread */
+        static inline MeshImport::Options OPTIONS;
+
+    private:
+        ///
+        /// @brief Queue one geometry of a link as a child prim
+        /// @param path Child prim, e.g. "visual"
+        /// @param origin Offset from the link
+        /// @param material Display color of primitives, may be null
+        /// @param purpose Render or proxy
+        /// @param layers Converted layer of each mesh file
+        ///
+        static void Author(StageQueue &queue,
+                           const pxr::SdfPath &path,
+                           const urdf::Pose &origin,
+                           const urdf::GeometrySharedPtr &geometry,
+                           const urdf::MaterialSharedPtr &material,
+                           const pxr::TfToken &purpose,
+                           const Layers &layers);
+
+    private:
+        struct Entry
+        {
+            std::filesystem::file_time_type Time;
+            bool Compact;
+            Prototype Value;
+        };
+
+        static inline std::mutex s_Mutex;
+
+        /* Guarded by `s_Mutex`, keyed by URDF path */
+        static inline std::unordered_map<std::string, Entry> s_Prototypes;
+    };
+}
\ No newline at end of file
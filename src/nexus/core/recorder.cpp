@@ -0,0 +1,272 @@
+#include "recorder.h"
+
+#include "pxr/base/gf/vec2d.h"
+#include "pxr/base/vt/array.h"
+#include "pxr/base/vt/dictionary.h"
+#include "pxr/usd/sdf/assetPath.h"
+#include "pxr/usd/sdf/attributeSpec.h"
+#include "pxr/usd/sdf/primSpec.h"
+#include "pxr/usd/sdf/schema.h"
+#include "pxr/usd/usd/clipsAPI.h"
+#include "pxr/usd/usd/tokens.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <format>
+
+// Built in memory and exported, so a file the stage has open is never cleared under it
+static auto Scratch(const std::filesystem::path &path)
+{
+    return pxr::SdfLayer::CreateAnonymous(path.extension().string());
+}
+
+static auto RootOf(const pxr::SdfPath &path)
+{
+    auto root = path.GetPrimPath();
+
+    while (!root.GetParentPath().IsAbsoluteRootPath())
+        root = root.GetParentPath();
+
+    return root;
+}
+
+void Nexus::Recorder::start(const std::string &path, const pxr::SdfLayerHandle &scene, const Reduction::Tolerance &tolerance)
+{
+    stop();
+
+    LOG_EVENT("Recording to <{}> in {:.0f}s chunks", path, ChunkSeconds);
+
+    m_Path = path;
+    m_Tolerance = tolerance;
+    m_Clips.clear();
+    m_Roots.clear();
+    m_Manifest.clear();
+    m_ManifestDirty = false;
+
+    // The only full copy, later structural edits are replayed on the writer thread
+    m_Scene = pxr::SdfLayer::CreateAnonymous();
+    m_Scene->TransferContent(scene);
+    m_SceneDirty = true;
+
+    m_Chunk = {};
+
+    m_Thread = std::jthread(
+        [this](std::stop_token token)
+        {
+            _run(token);
+        });
+}
+
+void Nexus::Recorder::stop()
+{
+    if (!m_Thread.joinable())
+        return;
+
+    if (!m_Chunk.Attributes.empty() || !m_Chunk.Structure.empty())
+        _submit(std::move(m_Chunk));
+
+    m_Chunk = {};
+    m_Thread.request_stop();
+    m_Condition.notify_all();
+    m_Thread.join();
+
+    LOG_EVENT("Recording stopped after {} chunks", m_Clips.size());
+}
+
+void Nexus::Recorder::record(const std::vector<StageQueue::Command> &commands)
+{
+    for (const auto &command : commands)
+    {
+        if (command.Type != StageQueue::Command::Kind::SET)
+        {
+            m_Chunk.Structure.push_back(command);
+            continue;
+        }
+
+        if (m_Chunk.Attributes.empty())
+        {
+            m_Chunk.Start = command.Time;
+            m_Chunk.End = command.Time;
+        }
+        m_Chunk.Attributes[command.Path].emplace_back(command.Time, command.Value);
+        m_Chunk.End = std::max(m_Chunk.End, command.Time);
+    }
+
+    if (!m_Chunk.Attributes.empty() && m_Chunk.End - m_Chunk.Start >= ChunkSeconds)
+    {
+        _submit(std::move(m_Chunk));
+        m_Chunk = {};
+    }
+}
+
+void Nexus::Recorder::_submit(Chunk &&chunk)
+{
+    {
+        std::lock_guard guard(m_Mutex);
+        m_Pending.push(std::move(chunk));
+    }
+    m_Condition.notify_one();
+}
+
+void Nexus::Recorder::_run(std::stop_token token)
+{
+    while (true)
+    {
+        Chunk chunk;
+        {
+            std::unique_lock lock(m_Mutex);
+
+            // Keeps draining after a stop request until nothing is pending
+            if (!m_Condition.wait(lock, token, [this]() { return !m_Pending.empty(); }))
+                return;
+
+            chunk = std::move(m_Pending.front());
+            m_Pending.pop();
+        }
+
+        if (!chunk.Structure.empty())
+        {
+            StageQueue::Apply(m_Scene, chunk.Structure);
+            m_SceneDirty = true;
+        }
+
+        if (m_SceneDirty)
+            _write_scene();
+
+        if (!chunk.Attributes.empty())
+            _write_chunk(chunk);
+
+        _write_root();
+    }
+}
+
+void Nexus::Recorder::_write_scene()
+{
+    const auto &scene = m_Scene;
+    std::vector<pxr::SdfPath> animated;
+
+    scene->Traverse(pxr::SdfPath::AbsoluteRootPath(),
+                    [&](const pxr::SdfPath &path)
+                    {
+                        if (path.IsPropertyPath() && scene->GetNumTimeSamplesForPath(path) > 0)
+                            animated.push_back(path);
+                    });
+
+    // Samples in the layer stack would be stronger than the clips
+    for (const auto &path : animated)
+        scene->EraseField(path, pxr::SdfFieldKeys->TimeSamples);
+
+    const auto file = (m_Path.parent_path() / "scene.usdc").string();
+
+    if (!scene->Export(file))
+        LOG_ERROR("Could not write scene to <{}>", file);
+
+    m_SceneDirty = false;
+}
+
+void Nexus::Recorder::_write_chunk(Chunk &chunk)
+{
+    const auto name = std::format("chunk_{:05}.usdc", m_Clips.size());
+    const auto file = (m_Path.parent_path() / name).string();
+    const auto layer = Scratch(file);
+
+    std::size_t removed = 0;
+
+    for (auto &[path, samples] : chunk.Attributes)
+    {
+        if (m_Tolerance.Enabled)
+            removed += Reduction::Reduce(samples, m_Tolerance);
+
+        auto type = m_Manifest.find(path);
+
+        if (type == m_Manifest.end())
+        {
+            const auto found = pxr::SdfSchema::GetInstance().FindType(samples.front().second);
+            type = m_Manifest.emplace(path, found).first;
+            m_Roots.insert(RootOf(path));
+            m_ManifestDirty = true;
+        }
+
+        const auto prim = pxr::SdfCreatePrimInLayer(layer, path.GetPrimPath());
+        pxr::SdfAttributeSpec::New(prim, path.GetName(), type->second);
+
+        for (const auto &[time, value] : samples)
+            layer->SetTimeSample(path, time, value);
+    }
+
+    if (!layer->Export(file))
+    {
+        LOG_ERROR("Could not save chunk at <{}>", file);
+        return;
+    }
+
+    m_Clips.emplace_back(chunk.Start, "./" + name);
+    m_End = chunk.End;
+
+    LOG_BASIC("Wrote {} with {} attributes ({} samples reduced)", name, chunk.Attributes.size(), removed);
+}
+
+void Nexus::Recorder::_write_root()
+{
+    const auto directory = m_Path.parent_path();
+
+    if (m_ManifestDirty)
+    {
+        const auto file = (directory / "manifest.usda").string();
+        const auto manifest = Scratch(file);
+
+        for (const auto &[path, type] : m_Manifest)
+        {
+            const auto prim = pxr::SdfCreatePrimInLayer(manifest, path.GetPrimPath());
+            pxr::SdfAttributeSpec::New(prim, path.GetName(), type);
+        }
+        if (!manifest->Export(file))
+            LOG_ERROR("Could not save manifest at <{}>", file);
+
+        m_ManifestDirty = false;
+    }
+
+    const auto root = Scratch(m_Path);
+
+    root->SetSubLayerPaths({"./scene.usdc"});
+    root->SetFramesPerSecond(144.0);
+    root->SetTimeCodesPerSecond(1.0);
+
+    if (!m_Clips.empty())
+    {
+        pxr::VtArray<pxr::SdfAssetPath> assets;
+        pxr::VtArray<pxr::GfVec2d> active;
+
+        for (std::size_t i = 0; i < m_Clips.size(); ++i)
+        {
+            assets.push_back(pxr::SdfAssetPath(m_Clips[i].second));
+            active.push_back(pxr::GfVec2d(m_Clips[i].first, static_cast<double>(i)));
+        }
+
+        // Chunks keep stage time so the mapping is the identity
+        const double start = m_Clips.front().first;
+        const pxr::VtArray<pxr::GfVec2d> times = {pxr::GfVec2d(start, start), pxr::GfVec2d(m_End, m_End)};
+
+        root->SetStartTimeCode(start);
+        root->SetEndTimeCode(m_End);
+
+        for (const auto &path : m_Roots)
+        {
+            pxr::VtDictionary clip;
+            clip[pxr::UsdClipsAPIInfoKeys->assetPaths.GetString()] = pxr::VtValue(assets);
+            clip[pxr::UsdClipsAPIInfoKeys->active.GetString()] = pxr::VtValue(active);
+            clip[pxr::UsdClipsAPIInfoKeys->times.GetString()] = pxr::VtValue(times);
+            clip[pxr::UsdClipsAPIInfoKeys->primPath.GetString()] = pxr::VtValue(path.GetString());
+            clip[pxr::UsdClipsAPIInfoKeys->manifestAssetPath.GetString()] = pxr::VtValue(pxr::SdfAssetPath("./manifest.usda"));
+
+            pxr::VtDictionary clips;
+            clips[pxr::UsdClipsAPISetNames->default_.GetString()] = pxr::VtValue(clip);
+
+            const auto prim = pxr::SdfCreatePrimInLayer(root, path);
+            prim->SetInfo(pxr::UsdTokens->clips, pxr::VtValue(clips));
+        }
+    }
+
+    if (!root->Export(m_Path.string()))
+        LOG_ERROR("Could not save recording at <{}>", m_Path.string());
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "reduction.h"
+#include "stage_queue.h"
+
+#include "nexus/logging.h"
+
+#include "pxr/base/vt/value.h"
+#include "pxr/usd/sdf/layer.h"
+#include "pxr/usd/sdf/path.h"
+#include "pxr/usd/sdf/valueTypeName.h"
+
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace Nexus
+{
+    ///
+    /// @brief Streams time samples into fixed-duration `.usdc` chunks on a
+    /// background thread and stitches them together with value clips.
+    ///
+    /// A recording at `<dir>/<name>.usda` sublayers `scene.usdc`, a copy of
+    /// the stage without time samples, and points every animated root prim
+    /// at `chunk_#####.usdc` through the default clip set.
+    ///
+    class Recorder : Logger<"Recorder">
+    {
+        using Samples = Reduction::Samples;
+
+        struct Chunk
+        {
+            double Start = 0.0;
+            double End = 0.0;
+
+            std::unordered_map<pxr::SdfPath, Samples, pxr::SdfPath::Hash> Attributes;
+
+            /* Structural commands of this chunk, replayed onto the writer's copy of the scene */
+            std::vector<StageQueue::Command> Structure;
+        };
+
+    public:
+        ~Recorder() { stop(); }
+
+        ///
+        /// @brief Begin a new recording
+        /// @param path Path of the recording root layer, e.g. `run.usda`
+        /// @param scene Layer whose structure is written to `scene.usdc`
+        /// @param tolerance Keyframe reduction applied to each chunk
+        ///
+        void start(const std::string &path, const pxr::SdfLayerHandle &scene, const Reduction::Tolerance &tolerance);
+
+        /* Flush the current chunk and wait for the writer to finish */
+        void stop();
+
+        ///
+        /// @brief Add a drained batch to the current chunk, without copying the scene
+        /// @param commands A drained batch from `StageQueue`
+        ///
+        void record(const std::vector<StageQueue::Command> &commands);
+
+        [[nodiscard]]
+        bool is_recording() const noexcept { return m_Thread.joinable(); }
+
+    public:
+        /* Duration of each chunk in seconds */
+        double ChunkSeconds = 10.0;
+
+    private:
+        void _submit(Chunk &&chunk);
+
+        void _run(std::stop_token token);
+
+        void _write_scene();
+
+        void _write_chunk(Chunk &chunk);
+
+        void _write_root();
+
+    private:
+        /* Main thread */
+        Chunk m_Chunk;
+
+        /* Shared with the writer */
+        std::mutex m_Mutex;
+        std::condition_variable_any m_Condition;
+        std::queue<Chunk> m_Pending;
+        std::jthread m_Thread;
+
+        /* Writer thread, `m_Scene` is copied once by `start` and kept up to date from chunks */
+        pxr::SdfLayerRefPtr m_Scene;
+        bool m_SceneDirty = false;
+        std::filesystem::path m_Path;
+        Reduction::Tolerance m_Tolerance;
+        std::vector<std::pair<double, std::string>> m_Clips;
+        double m_End = 0.0;
+        std::unordered_set<pxr::SdfPath, pxr::SdfPath::Hash> m_Roots;
+        std::unordered_map<pxr::SdfPath, pxr::SdfValueTypeName, pxr::SdfPath::Hash> m_Manifest;
+        bool m_ManifestDirty = false;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include "reduction.h"
+
+#include "pxr/base/gf/vec3d.h"
+#include "pxr/usd/sdf/schema.h"
+#include "pxr/usd/sdf/types.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+// Bounds the cost of long stationary stretches
+constexpr std::size_t MAX_SPAN = 256;
+
+bool Nexus::Reduction::Within(const pxr::GfMatrix4d &a, const pxr::GfMatrix4d &b, const Tolerance &tolerance) noexcept
+{
+    // Chord length of each rotated axis, which also catches the
+    // shrinking that component-wise interpolation introduces
+    const double chord = 2.0 * std::sin(tolerance.Angle * std::numbers::pi / 360.0);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        if ((a.GetRow3(i) - b.GetRow3(i)).GetLengthSq() > chord * chord)
+            return false;
+    }
+    return (a.ExtractTranslation() - b.ExtractTranslation()).GetLengthSq() <=
+           tolerance.Position * tolerance.Position;
+}
+
+std::size_t Nexus::Reduction::Reduce(Samples &samples, const Tolerance &tolerance)
+{
+    if (samples.size() < 3)
+        return 0;
+
+    const bool matrices = std::all_of(samples.begin(), samples.end(),
+                                      [](const auto &sample)
+                                      {
+                                          return sample.second.template IsHolding<pxr::GfMatrix4d>();
+                                      });
+    if (!matrices)
+        return 0;
+
+    auto value = [&](std::size_t i) -> const pxr::GfMatrix4d &
+    {
+        return samples[i].second.UncheckedGet<pxr::GfMatrix4d>();
+    };
+
+    // Can samples (from, to) be interpolated from `from` and `to`?
+    auto spans = [&](std::size_t from, std::size_t to)
+    {
+        const double t0 = samples[from].first;
+        const double t1 = samples[to].first;
+
+        for (std::size_t i = from + 1; i < to; ++i)
+        {
+            const double alpha = (samples[i].first - t0) / (t1 - t0);
+            const auto lerp = value(from) * (1.0 - alpha) + value(to) * alpha;
+
+            if (!Within(lerp, value(i), tolerance))
+                return false;
+        }
+        return true;
+    };
+
+    std::vector<std::size_t> keep = {0};
+
+    for (std::size_t i = 2; i < samples.size(); ++i)
+    {
+        if (i - keep.back() > MAX_SPAN || !spans(keep.back(), i))
+            keep.push_back(i - 1);
+    }
+    keep.push_back(samples.size() - 1);
+
+    const std::size_t removed = samples.size() - keep.size();
+
+    for (std::size_t i = 0; i < keep.size(); ++i)
+    {
+        if (i != keep[i])
+            samples[i] = std::move(samples[keep[i]]);
+    }
+
+    samples.resize(keep.size());
+    return removed;
+}
+
+std::size_t Nexus::Reduction::Reduce(const pxr::SdfLayerHandle &layer, const Tolerance &tolerance)
+{
+    std::vector<pxr::SdfPath> animated;
+
+    layer->Traverse(pxr::SdfPath::AbsoluteRootPath(),
+                    [&](const pxr::SdfPath &path)
+                    {
+                        if (path.IsPropertyPath() && layer->GetNumTimeSamplesForPath(path) > 2)
+                            animated.push_back(path);
+                    });
+
+    std::size_t removed = 0;
+    std::size_t total = 0;
+
+    for (const auto &path : animated)
+    {
+        const auto map = layer->GetFieldAs<pxr::SdfTimeSampleMap>(path, pxr::SdfFieldKeys->TimeSamples);
+        Samples samples(map.begin(), map.end());
+        total += samples.size();
+
+        const auto count = Reduce(samples, tolerance);
+
+        if (count == 0)
+            continue;
+
+        pxr::SdfTimeSampleMap reduced(samples.begin(), samples.end());
+        layer->SetField(path, pxr::SdfFieldKeys->TimeSamples, pxr::VtValue(std::move(reduced)));
+        removed += count;
+    }
+
+    LOG_EVENT("Removed {} of {} samples across {} attributes", removed, total, animated.size());
+    return removed;
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "nexus/logging.h"
+
+#include "pxr/base/gf/matrix4d.h"
+#include "pxr/base/vt/value.h"
+#include "pxr/usd/sdf/layer.h"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace Nexus
+{
+    ///
+    /// @brief Lossy keyframe reduction for `matrix4d` time samples.
+    /// A sample is dropped when linear interpolation between the samples
+    /// that are kept reproduces it within the tolerance, which is how USD
+    /// evaluates matrices between time samples on playback.
+    ///
+    class Reduction : Logger<"Reduction">
+    {
+    public:
+        using Samples = std::vector<std::pair<double, pxr::VtValue>>;
+
+        struct Tolerance
+        {
+            bool Enabled = true;
+
+            /* Largest translation error in stage units */
+            double Position = 0.0005;
+
+            /* Largest rotation error in degrees */
+            double Angle = 0.1;
+        };
+
+        ///
+        /// @brief Whether two transforms are within the tolerance
+        /// @param a First transform
+        /// @param b Second transform
+        /// @param tolerance Positional and angular thresholds
+        ///
+        [[nodiscard]]
+        static bool Within(const pxr::GfMatrix4d &a, const pxr::GfMatrix4d &b, const Tolerance &tolerance) noexcept;
+
+        ///
+        /// @brief Drop redundant samples in place, leaving non-matrix samples untouched
+        /// @param samples Samples ordered by time
+        /// @param tolerance Positional and angular thresholds
+        /// @return Number of samples removed
+        ///
+        static std::size_t Reduce(Samples &samples, const Tolerance &tolerance);
+
+        ///
+        /// @brief Reduce every time-sampled attribute of a layer
+        /// @param layer Layer to edit, usually a snapshot
+        /// @param tolerance Positional and angular thresholds
+        /// @return Number of samples removed
+        ///
+        static std::size_t Reduce(const pxr::SdfLayerHandle &layer, const Tolerance &tolerance);
+    };
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "retention.h"
+
+#include "pxr/usd/sdf/changeBlock.h"
+
+#include <algorithm>
+#include <iterator>
+
+void Nexus::Retention::track(const std::vector<StageQueue::Command> &commands)
+{
+    for (const auto &command : commands)
+    {
+        if (command.Type == StageQueue::Command::Kind::SET)
+            m_Paths.insert(command.Path);
+    }
+}
+
+std::size_t Nexus::Retention::evict(const pxr::SdfLayerHandle &layer, double now)
+{
+    if (now - m_Last < Settings.Interval)
+        return 0;
+
+    m_Last = now;
+
+    if (Settings.Seconds <= 0.0 && Settings.Samples <= 0)
+        return 0;
+
+    const double cutoff = now - Settings.Seconds;
+    std::size_t erased = 0;
+
+    pxr::SdfChangeBlock block;
+
+    for (const auto &path : m_Paths)
+    {
+        const auto times = layer->ListTimeSamplesForPath(path);
+        std::size_t count = 0;
+
+        if (Settings.Seconds > 0.0)
+            count = std::distance(times.begin(), times.lower_bound(cutoff));
+
+        if (Settings.Samples > 0 && times.size() > static_cast<std::size_t>(Settings.Samples))
+            count = std::max(count, times.size() - Settings.Samples);
+
+        // A still link may not be sampled again for a long time
+        if (!times.empty() && count >= times.size())
+            count = times.size() - 1;
+
+        auto it = times.begin();
+
+        for (std::size_t i = 0; i < count; ++i, ++it)
+            layer->EraseTimeSample(path, *it);
+
+        erased += count;
+    }
+
+    if (erased > 0)
+        LOG_BASIC("Evicted {} time samples from {} attributes", erased, m_Paths.size());
+
+    return erased;
+}
+
+void Nexus::Retention::reset()
+{
+    m_Paths.clear();
+    m_Last = 0.0;
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "stage_queue.h"
+
+#include "nexus/logging.h"
+
+#include "pxr/usd/sdf/layer.h"
+#include "pxr/usd/sdf/path.h"
+
+#include <cstddef>
+#include <unordered_set>
+#include <vector>
+
+namespace Nexus
+{
+    ///
+    /// @brief Bounds the time samples kept in a layer so that live
+    /// recording uses a flat amount of memory.
+    ///
+    class Retention : Logger<"Retention">
+    {
+    public:
+        struct Policy
+        {
+            /* Keep samples newer than this many seconds (0 = forever), off by default */
+            double Seconds = 0.0;
+
+            /* Keep at most this many samples per attribute (0 = unbounded) */
+            int Samples = 0;
+
+            /* Seconds between bulk evictions */
+            double Interval = 1.0;
+        };
+
+        ///
+        /// @brief Remember the attributes that received time samples
+        /// @param commands A drained batch from `StageQueue`
+        ///
+        void track(const std::vector<StageQueue::Command> &commands);
+
+        ///
+        /// @brief Erase samples outside of the policy if the interval elapsed
+        /// @param layer Layer holding the samples
+        /// @param now Current time code
+        /// @return Number of samples erased
+        ///
+        std::size_t evict(const pxr::SdfLayerHandle &layer, double now);
+
+        /* Forget tracked attributes, e.g. when the stage is replaced */
+        void reset();
+
+    public:
+        Policy Settings;
+
+    private:
+        double m_Last = 0.0;
+
+        std::unordered_set<pxr::SdfPath, pxr::SdfPath::Hash> m_Paths;
+    };
+}
\ No newline at end of file
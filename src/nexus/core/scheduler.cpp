@@ -0,0 +1,132 @@
+#include "scheduler.h"
+
+#include <algorithm>
+#include <chrono>
+
+Nexus::Scheduler::Scheduler()
+    : m_Pool(std::max(std::thread::hardware_concurrency(), 2u) / 2)
+{
+}
+
+void Nexus::Scheduler::start()
+{
+    if (m_Thread.joinable())
+        return;
+
+    LOG_EVENT("Starting at {} Hz with {} threads", Rate.load(), m_Pool.size());
+    m_Thread = std::jthread([this](std::stop_token stop)
+                            { _run(stop); });
+}
+
+void Nexus::Scheduler::stop()
+{
+    if (!m_Thread.joinable())
+        return;
+
+    m_Thread.request_stop();
+    m_Thread.join();
+    LOG_EVENT("Stopped");
+}
+
+void Nexus::Scheduler::add(const std::shared_ptr<Entity> &entity)
+{
+    std::scoped_lock lock(m_Mutex);
+    const void *key = entity->_batch_key();
+
+    if (key == nullptr)
+    {
+        m_Entities.push_back(entity);
+        return;
+    }
+
+    const auto batch = std::ranges::find(m_Batches, key, &Batch::Key);
+
+    if (batch == m_Batches.end())
+        m_Batches.push_back({key, {entity}});
+    else
+        batch->Entities.push_back(entity);
+}
+
+void Nexus::Scheduler::remove(const std::shared_ptr<Entity> &entity)
+{
+    std::scoped_lock lock(m_Mutex);
+    std::erase(m_Entities, entity);
+
+    for (auto &batch : m_Batches)
+        std::erase(batch.Entities, entity);
+
+    std::erase_if(m_Batches, [](const Batch &batch)
+                  { return batch.Entities.empty(); });
+}
+
+Nexus::Scheduler::Stats Nexus::Scheduler::stats() const
+{
+    std::scoped_lock lock(m_Mutex);
+    return m_Stats;
+}
+
+void Nexus::Scheduler::_run(std::stop_token stop)
+{
+    using namespace std::chrono;
+    using Milliseconds = duration<double, std::milli>;
+
+    std::vector<std::shared_ptr<Entity>> entities;
+    std::vector<Batch> batched;
+    auto last = steady_clock::now();
+    auto next = last;
+    auto window = last;
+    double worst = 0.0;
+
+    while (!stop.stop_requested())
+    {
+        const auto period = duration_cast<steady_clock::duration>(duration<double>(1.0 / std::max(Rate.load(), 1.0)));
+        next += period;
+        std::this_thread::sleep_until(next);
+
+        const auto woke = steady_clock::now();
+        const double late = Milliseconds(woke - next).count();
+
+        // Skip ticks that were missed instead of bursting to catch up
+        if (woke - next > period)
+            next = woke;
+
+        {
+            std::scoped_lock lock(m_Mutex);
+            entities = m_Entities;
+            batched = m_Batches;
+        }
+
+        // One job per `BATCH` lone entities, then one per batch of entities sharing a key
+        const std::size_t batches = (entities.size() + BATCH - 1) / BATCH;
+
+        m_Pool.run(batches + batched.size(), [&entities, &batched, batches](std::size_t batch)
+                   {
+                       if (batch >= batches)
+                       {
+                           const auto &shared = batched[batch - batches].Entities;
+                           shared.front()->tick_batch(shared);
+                           return;
+                       }
+                       const auto end = std::min(entities.size(), (batch + 1) * BATCH);
+
+                       for (auto i = batch * BATCH; i < end; ++i)
+                           entities[i]->tick(); });
+
+        const auto done = steady_clock::now();
+        worst = std::max(worst, late);
+
+        std::scoped_lock lock(m_Mutex);
+        m_Stats.Period += 0.1 * (Milliseconds(woke - last).count() - m_Stats.Period);
+        m_Stats.Jitter += 0.1 * (late - m_Stats.Jitter);
+        m_Stats.Busy += 0.1 * (Milliseconds(done - woke).count() - m_Stats.Busy);
+        last = woke;
+
+        // The worst case is over the last second
+        if (woke - window > seconds(1))
+        {
+            m_Stats.Worst = worst;
+            worst = 0.0;
+            window = woke;
+        }
+    }
+}
\ No newline at end of file
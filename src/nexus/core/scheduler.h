@@ -0,0 +1,84 @@
+#pragma once
+
+#include "thread_pool.h"
+
+#include "nexus/entity/entity.h"
+#include "nexus/logging.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Nexus
+{
+    ///
+    /// @brief Ticks every entity at a fixed rate from one thread, in batches
+    /// spread over a `ThreadPool`, instead of a timer per entity.
+    /// Entities sharing a batch key are ticked together by a single job.
+    ///
+    class Scheduler : Logger<"Scheduler">
+    {
+        /* Entities with the same `Entity::_batch_key` */
+        struct Batch
+        {
+            const void *Key = nullptr;
+            std::vector<std::shared_ptr<Entity>> Entities;
+        };
+
+    public:
+        struct Stats
+        {
+            /* Measured time between ticks in milliseconds */
+            double Period = 0.0;
+
+            /* Smoothed and worst lateness of a tick in milliseconds */
+            double Jitter = 0.0;
+            double Worst = 0.0;
+
+            /* Time spent ticking in milliseconds */
+            double Busy = 0.0;
+        };
+
+    public:
+        Scheduler();
+
+        ~Scheduler() { stop(); }
+
+        void start();
+
+        void stop();
+
+        void add(const std::shared_ptr<Entity> &entity);
+
+        void remove(const std::shared_ptr<Entity> &entity);
+
+        [[nodiscard]]
+        Stats stats() const;
+
+    public:
+        /* Ticks per second, may change while running */
+        std::atomic<double> Rate = 100.0;
+
+        /* Entities ticked by one job of the pool */
+        static constexpr std::size_t BATCH = 4;
+
+    private:
+        void _run(std::stop_token stop);
+
+    private:
+        mutable std::mutex m_Mutex;
+
+        /* Entities without a batch key, and those with one grouped by it */
+        std::vector<std::shared_ptr<Entity>> m_Entities;
+        std::vector<Batch> m_Batches;
+
+        Stats m_Stats;
+
+        ThreadPool m_Pool;
+
+        std::jthread m_Thread;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,160 @@
+#include "stage_queue.h"
+
+#include "pxr/usd/sdf/attributeSpec.h"
+#include "pxr/usd/sdf/changeBlock.h"
+#include "pxr/usd/sdf/copyUtils.h"
+#include "pxr/usd/sdf/primSpec.h"
+#include "pxr/usd/sdf/reference.h"
+
+#include <chrono>
+
+void Nexus::StageQueue::define(const pxr::SdfPath &path, const pxr::TfToken &schema)
+{
+    _push({.Type = Command::Kind::DEFINE, .Path = path, .Schema = schema});
+}
+
+void Nexus::StageQueue::create(const pxr::SdfPath &path,
+                               const pxr::SdfValueTypeName &type,
+                               pxr::VtValue value,
+                               pxr::SdfVariability variability)
+{
+    _push({.Type = Command::Kind::CREATE,
+           .Path = path,
+           .Value = std::move(value),
+           .ValueType = type,
+           .Variability = variability});
+}
+
+void Nexus::StageQueue::set(const pxr::SdfPath &path, pxr::VtValue value, double time)
+{
+    _push({.Type = Command::Kind::SET, .Path = path, .Value = std::move(value), .Time = time});
+}
+
+void Nexus::StageQueue::reference(const pxr::SdfPath &path, const std::string &asset, bool instanceable)
+{
+    _push({.Type = Command::Kind::REFERENCE, .Path = path, .Value = pxr::VtValue(instanceable), .Asset = asset});
+}
+
+void Nexus::StageQueue::copy(const pxr::SdfPath &path, pxr::SdfLayerRefPtr source, const pxr::SdfPath &from)
+{
+    _push({.Type = Command::Kind::COPY, .Path = path, .Source = std::move(source), .From = from});
+}
+
+auto Nexus::StageQueue::drain(const pxr::SdfLayerHandle &layer, const Observer &observer) -> Stats
+{
+    using namespace std::chrono;
+    const auto start = steady_clock::now();
+
+    {
+        std::lock_guard guard(m_Mutex);
+        std::swap(m_Commands, m_Draining);
+    }
+
+    if (m_Draining.empty())
+        return {};
+
+    Apply(layer, m_Draining);
+
+    if (observer)
+        observer(m_Draining);
+
+    Stats stats;
+    stats.Commands = m_Draining.size();
+    stats.Milliseconds = duration<double, std::milli>(steady_clock::now() - start).count();
+
+    m_Draining.clear();
+    return stats;
+}
+
+void Nexus::StageQueue::Apply(const pxr::SdfLayerHandle &layer, const std::vector<Command> &commands)
+{
+    pxr::SdfChangeBlock block;
+
+    for (const auto &command : commands)
+    {
+        switch (command.Type)
+        {
+        case Command::Kind::DEFINE:
+        {
+            auto prim = pxr::SdfCreatePrimInLayer(layer, command.Path);
+
+            if (!prim)
+            {
+                LOG_ERROR("Could not define prim at {}", command.Path.GetString());
+                break;
+            }
+            prim->SetSpecifier(pxr::SdfSpecifierDef);
+            prim->SetTypeName(command.Schema.GetString());
+            break;
+        }
+        case Command::Kind::CREATE:
+        {
+            auto attribute = layer->GetAttributeAtPath(command.Path);
+
+            if (!attribute)
+            {
+                auto prim = layer->GetPrimAtPath(command.Path.GetPrimPath());
+
+                if (!prim)
+                {
+                    LOG_ERROR("No prim to own attribute {}", command.Path.GetString());
+                    break;
+                }
+                attribute = pxr::SdfAttributeSpec::New(prim,
+                                                       command.Path.GetName(),
+                                                       command.ValueType,
+                                                       command.Variability);
+            }
+
+            if (!attribute)
+            {
+                LOG_ERROR("Could not create attribute {}", command.Path.GetString());
+                break;
+            }
+
+            if (!command.Value.IsEmpty())
+                attribute->SetDefaultValue(command.Value);
+
+            break;
+        }
+        case Command::Kind::SET:
+            layer->SetTimeSample(command.Path, command.Time, command.Value);
+            break;
+        case Command::Kind::REFERENCE:
+        {
+            auto prim = layer->GetPrimAtPath(command.Path);
+
+            if (!prim)
+            {
+                LOG_ERROR("No prim to hold reference {}", command.Path.GetString());
+                break;
+            }
+            prim->GetReferenceList().Prepend(pxr::SdfReference(command.Asset));
+
+            if (command.Value.GetWithDefault(false))
+                prim->SetInstanceable(true);
+            break;
+        }
+        case Command::Kind::COPY:
+        {
+            const auto parent = command.Path.GetParentPath();
+
+            if (!parent.IsAbsoluteRootPath() && !pxr::SdfJustCreatePrimInLayer(layer, parent))
+            {
+                LOG_ERROR("Could not create parent of {}", command.Path.GetString());
+                break;
+            }
+
+            if (!pxr::SdfCopySpec(command.Source, command.From, layer, command.Path))
+                LOG_ERROR("Could not copy prim to {}", command.Path.GetString());
+            break;
+        }
+        }
+    }
+}
+
+void Nexus::StageQueue::_push(Command &&command)
+{
+    std::lock_guard guard(m_Mutex);
+    m_Commands.push_back(std::move(command));
+}
\ No newline at end of file
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "nexus/logging.h"
+
+#include "pxr/base/tf/token.h"
+#include "pxr/base/vt/value.h"
+#include "pxr/usd/sdf/layer.h"
+#include "pxr/usd/sdf/path.h"
+#include "pxr/usd/sdf/types.h"
+#include "pxr/usd/sdf/valueTypeName.h"
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Nexus
+{
+    ///
+    /// @brief A queue of Sdf-level edits applied in a single `SdfChangeBlock`
+    /// so that the stage recomposes and Hydra resyncs once per batch.
+    ///
+    class StageQueue : Logger<"Stage Queue">
+    {
+    public:
+        struct Command
+        {
+            enum class Kind : char
+            {
+                DEFINE,
+                CREATE,
+                SET,
+                REFERENCE,
+                COPY
+            };
+
+            Kind Type;
+            pxr::SdfPath Path;
+            pxr::VtValue Value;
+
+            /* DEFINE: schema type of the prim */
+            pxr::TfToken Schema;
+
+            /* CREATE: value type of the attribute */
+            pxr::SdfValueTypeName ValueType;
+            pxr::SdfVariability Variability = pxr::SdfVariabilityVarying;
+
+            /* SET: time code of the sample */
+            double Time = 0.0;
+
+            /* REFERENCE: layer to reference, `Value` holds whether the prim is instanceable */
+            std::string Asset;
+
+            /* COPY: layer holding the prim to copy, and its path there */
+            pxr::SdfLayerRefPtr Source;
+            pxr::SdfPath From;
+        };
+
+        /* Sees every drained batch after it has been applied */
+        using Observer = std::function<void(const std::vector<Command> &)>;
+
+        struct Stats
+        {
+            std::size_t Commands = 0;
+            double Milliseconds = 0.0;
+        };
+
+        ///
+        /// @brief Define a typed prim, creating parents as `over` if needed
+        /// @param path Prim path
+        /// @param schema Prim type name, e.g. "Xform"
+        ///
+        void define(const pxr::SdfPath &path, const pxr::TfToken &schema);
+
+        ///
+        /// @brief Create an attribute with an optional default value
+        /// @param path Property path
+        /// @param type Value type of the attribute
+        /// @param value Default value or empty
+        /// @param variability Varying or uniform
+        ///
+        void create(const pxr::SdfPath &path,
+                    const pxr::SdfValueTypeName &type,
+                    pxr::VtValue value = {},
+                    pxr::SdfVariability variability = pxr::SdfVariabilityVarying);
+
+        ///
+        /// @brief Author a time sample on an existing attribute
+        /// @param path Property path
+        /// @param value Sample value
+        /// @param time Time code
+        ///
+        void set(const pxr::SdfPath &path, pxr::VtValue value, double time);
+
+        ///
+        /// @brief Prepend a reference to the default prim of another layer
+        /// @param path Prim path, defined earlier
+        /// @param asset Layer identifier or file path
+        /// @param instanceable Share the composed prims with every other
+        /// instanceable prim that has the same arcs
+        ///
+        void reference(const pxr::SdfPath &path, const std::string &asset, bool instanceable = false);
+
+        ///
+        /// @brief Copy a prim and its children from another layer, replacing what is there
+        /// @param path Destination prim path
+        /// @param source Layer built beforehand, not edited afterwards
+        /// @param from Prim path in `source`
+        ///
+        void copy(const pxr::SdfPath &path, pxr::SdfLayerRefPtr source, const pxr::SdfPath &from);
+
+        ///
+        /// @brief Apply every queued command to `layer`.
+        /// Only one thread may drain a queue; any thread may enqueue.
+        /// @param layer Destination layer
+        /// @param observer Called with the applied batch, if any
+        /// @return Number of commands applied and time taken
+        ///
+        Stats drain(const pxr::SdfLayerHandle &layer, const Observer &observer = {});
+
+        ///
+        /// @brief Apply commands in order inside one `SdfChangeBlock`
+        /// @param layer Destination layer
+        /// @param commands Commands to apply
+        ///
+        static void Apply(const pxr::SdfLayerHandle &layer, const std::vector<Command> &commands);
+
+    private:
+        void _push(Command &&command);
+
+    private:
+        std::mutex m_Mutex;
+
+        std::vector<Command> m_Commands;
+
+        /* Swapped with `m_Commands` on drain to reuse capacity */
+        std::vector<Command> m_Draining;
+    };
+}
\ No newline at end of file
@@ -5,12 +5,15 @@
 namespace Nexus
 {
     class World;
-    class Entity;
 
+    ///
+    /// @brief Lock shared between the main thread and the executor.
+    /// `Mutex` guards the stage and is only held for structural edits
+    /// and draining the stage queue. Entities never take it, they queue edits.
+    ///
     class Sync
     {
         friend class World;
-        friend class Entity;
 
         static void Lock() { Mutex.lock(); }
         static void Unlock() { Mutex.unlock(); }
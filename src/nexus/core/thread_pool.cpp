@@ -0,0 +1,71 @@
+#include "thread_pool.h"
+
+Nexus::ThreadPool::ThreadPool(std::size_t threads)
+{
+    m_Workers.reserve(threads);
+
+    for (std::size_t i = 0; i < threads; ++i)
+        m_Workers.emplace_back([this](std::stop_token stop)
+                               { _work(stop); });
+}
+
+void Nexus::ThreadPool::run(std::size_t count, const Job &job)
+{
+    if (count == 0)
+        return;
+
+    // Shared so workers still holding it after the last index stay valid
+    const auto loop = std::make_shared<Loop>();
+    loop->Body = &job;
+    loop->Count = count;
+    {
+        std::scoped_lock lock(m_Mutex);
+        m_Loops.push_back(loop);
+    }
+    m_Wake.notify_all();
+
+    _drain(*loop);
+
+    std::unique_lock lock(m_Mutex);
+    m_Done.wait(lock, [&loop]
+                { return loop->Finished == loop->Count; });
+}
+
+void Nexus::ThreadPool::_work(std::stop_token stop)
+{
+    while (true)
+    {
+        std::shared_ptr<Loop> loop;
+        {
+            std::unique_lock lock(m_Mutex);
+
+            if (!m_Wake.wait(lock, stop, [this]
+                             { return !m_Loops.empty(); }))
+                return;
+
+            loop = m_Loops.front();
+        }
+
+        _drain(*loop);
+    }
+}
+
+void Nexus::ThreadPool::_drain(Loop &loop)
+{
+    for (std::size_t i = loop.Next++; i < loop.Count; i = loop.Next++)
+    {
+        (*loop.Body)(i);
+
+        if (++loop.Finished == loop.Count)
+        {
+            // Under the lock so the caller cannot miss it between checking and waiting
+            std::scoped_lock lock(m_Mutex);
+            m_Done.notify_all();
+        }
+    }
+
+    // Every index is handed out, so nobody needs to find this loop again
+    std::scoped_lock lock(m_Mutex);
+    std::erase_if(m_Loops, [&loop](const auto &queued)
+                  { return queued.get() == &loop; });
+}
\ No newline at end of file
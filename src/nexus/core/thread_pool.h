@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace Nexus
+{
+    ///
+    /// @brief A fixed set of worker threads for data-parallel loops.
+    /// Jobs are handed out by an atomic counter, and the calling thread
+    /// takes part too, so `run` returns once every index has been processed.
+    /// Loops from concurrent callers share the workers instead of waiting
+    /// for each other.
+    ///
+    class ThreadPool
+    {
+    public:
+        using Job = std::function<void(std::size_t)>;
+
+        ///
+        /// @param threads Number of workers besides the calling thread
+        ///
+        explicit ThreadPool(std::size_t threads);
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        ///
+        /// @brief Call `job(i)` for every `i` in `[0, count)` and wait.
+        /// Safe to call from several threads at once, including from a job.
+        /// @param count Number of indices
+        /// @param job Called concurrently from several threads
+        ///
+        void run(std::size_t count, const Job &job);
+
+        [[nodiscard]]
+        std::size_t size() const noexcept { return m_Workers.size() + 1; }
+
+    private:
+        /* One call to `run` */
+        struct Loop
+        {
+            /* Owned by the caller, only called for indices below `Count` */
+            const Job *Body = nullptr;
+            std::size_t Count = 0;
+
+            std::atomic<std::size_t> Next = 0;
+            std::atomic<std::size_t> Finished = 0;
+        };
+
+        void _work(std::stop_token stop);
+
+        void _drain(Loop &loop);
+
+    private:
+        std::mutex m_Mutex;
+        std::condition_variable_any m_Wake;
+        std::condition_variable m_Done;
+
+        /* Loops with indices left to hand out, oldest first */
+        std::deque<std::shared_ptr<Loop>> m_Loops;
+
+        /* Last so they stop before the state above is destroyed */
+        std::vector<std::jthread> m_Workers;
+    };
+}
\ No newline at end of file
@@ -1,11 +1,17 @@
 #include "world.h"
 
+#include "nexus/convert/mesh_cache.h"
 #include "nexus/event/event_client.h"
 #include "nexus/event/scene_reset_event.h"
 
+#include "pxr/usd/ar/resolver.h"
 #include "pxr/usd/usdGeom/cylinder.h"
 #include "pxr/usd/usdGeom/metrics.h"
 #include "pxr/usd/usdLux/domeLight.h"
+#include "pxr/usd/usdUtils/dependencies.h"
+
+#include <algorithm>
+#include <filesystem>
 
 auto Nexus::World::CreateDefaultStage() -> pxr::UsdStageRefPtr
 {
@@ -48,6 +54,7 @@ void Nexus::World::NewStage(const std::string &path)
     LOG_EVENT("Creating new stage at <{}>", path);
     Sync::Lock();
     s_Stage = pxr::UsdStage::CreateNew(path);
+    s_Retention.reset();
 
     if (!pxr::UsdGeomSetStageUpAxis(s_Stage, pxr::UsdGeomTokens->z))
         LOG_ALERT("Stage could not set up axis to Z");
@@ -64,6 +71,7 @@ void Nexus::World::OpenStage(const std::string &path)
     LOG_EVENT("Opening stage at <{}>", path);
     Sync::Lock();
     s_Stage = pxr::UsdStage::Open(path);
+    s_Retention.reset();
     Sync::Unlock();
     EventClient::Send<SceneResetEvent>();
 }
@@ -72,22 +80,142 @@ void Nexus::World::SaveStage()
 {
     LOG_EVENT("Saving stage...");
     Sync::Lock();
-    s_Stage->SetFramesPerSecond(144.0);
-    s_Stage->SetTimeCodesPerSecond(1.0);
-    s_Stage->SetStartTimeCode(1.0);
-    s_Stage->SetEndTimeCode(World::GetTime());
-    s_Stage->Save();
+    const auto path = s_Stage->GetRootLayer()->GetRealPath();
+    Snapshot snapshot;
+
+    if (!path.empty())
+        snapshot = TakeSnapshot(false);
+
     Sync::Unlock();
+
+    if (!snapshot.Root)
+    {
+        LOG_ALERT("Stage is in memory, export it instead");
+        return;
+    }
+    WriteSnapshot(std::move(snapshot), path);
 }
 
 void Nexus::World::ExportStage(const std::string &path)
 {
     LOG_EVENT("Exporting stage to <{}>", path);
     Sync::Lock();
+    auto snapshot = TakeSnapshot(true);
+    Sync::Unlock();
+    WriteSnapshot(std::move(snapshot), path);
+}
+
+auto Nexus::World::TakeSnapshot(bool flatten) -> Snapshot
+{
     s_Stage->SetFramesPerSecond(144.0);
     s_Stage->SetTimeCodesPerSecond(1.0);
     s_Stage->SetStartTimeCode(1.0);
     s_Stage->SetEndTimeCode(World::GetTime());
-    s_Stage->Export(path);
+
+    Snapshot snapshot;
+    snapshot.Root = pxr::SdfLayer::CreateAnonymous();
+    snapshot.Root->TransferContent(s_Stage->GetRootLayer());
+
+    // Flattening is left to the writer, only the cheap copies happen under the lock
+    if (flatten)
+    {
+        snapshot.Session = pxr::SdfLayer::CreateAnonymous();
+        snapshot.Session->TransferContent(s_Stage->GetSessionLayer());
+        snapshot.Anchor = s_Stage->GetRootLayer()->GetRealPath();
+    }
+    return snapshot;
+}
+
+void Nexus::World::WriteSnapshot(Snapshot snapshot, const std::string &path)
+{
+    if (s_Saving.exchange(true))
+    {
+        LOG_ALERT("Already saving, try again later");
+        return;
+    }
+
+    s_Saver = std::jthread(
+        [snapshot = std::move(snapshot), path, tolerance = s_Tolerance]()
+        {
+            using namespace std::chrono;
+            const auto start = steady_clock::now();
+            auto layer = snapshot.Root;
+
+            // Like `UsdStage::Export`, so references and sublayers survive a move
+            if (snapshot.Session)
+            {
+                // The copy is anonymous, so relative paths would no longer resolve next to the original
+                const auto anchor = [&snapshot](const std::string &asset)
+                {
+                    if (asset.empty() || snapshot.Anchor.empty())
+                        return asset;
+
+                    return pxr::ArGetResolver().CreateIdentifier(asset, pxr::ArResolvedPath(snapshot.Anchor));
+                };
+
+                pxr::UsdUtilsModifyAssetPaths(layer, anchor);
+                layer = pxr::UsdStage::Open(layer, snapshot.Session)->Flatten();
+            }
+
+            if (tolerance.Enabled)
+                Reduction::Reduce(layer, tolerance);
+
+            // Robots reference converted meshes in the cache, which may be purged or on another machine
+            if (const auto count = MeshCache::Localize(layer, std::filesystem::path(path).parent_path()))
+                LOG_BASIC("Made {} cached mesh references relative to <{}>", count, path);
+
+            if (layer->Export(path))
+            {
+                const auto elapsed = duration<double>(steady_clock::now() - start).count();
+                LOG_EVENT("Wrote <{}> in {:.2f}s", path, elapsed);
+            }
+            else
+            {
+                LOG_ERROR("Could not write <{}>", path);
+            }
+            s_Saving = false;
+        });
+}
+
+void Nexus::World::StartRecording(const std::string &path)
+{
+    Sync::Lock();
+    s_Recorder.start(path, s_Stage->GetRootLayer(), s_Tolerance);
+    Sync::Unlock();
+}
+
+void Nexus::World::StopRecording()
+{
+    s_Recorder.stop();
+}
+
+void Nexus::World::Update()
+{
+    // Entities only queue edits, so readers of the stage are not held up by them
+    for (auto &entity : s_Entities)
+        entity->update();
+
+    Sync::Lock();
+    const auto layer = s_Stage->GetRootLayer();
+
+    s_QueueStats = s_Queue.drain(layer,
+                                 [](const std::vector<StageQueue::Command> &commands)
+                                 {
+                                     const auto structural = [](const StageQueue::Command &command)
+                                     {
+                                         return command.Type != StageQueue::Command::Kind::SET;
+                                     };
+
+                                     if (std::ranges::any_of(commands, structural))
+                                         s_Structure++;
+
+                                     s_Retention.track(commands);
+
+                                     if (s_Recorder.is_recording())
+                                         s_Recorder.record(commands);
+                                 });
+
+    s_Retention.evict(layer, World::GetTime());
+
     Sync::Unlock();
 }
\ No newline at end of file
@@ -1,19 +1,26 @@
 #pragma once
 
+#include "recorder.h"
+#include "reduction.h"
+#include "retention.h"
+#include "scheduler.h"
+#include "stage_queue.h"
 #include "sync.h"
 
 #include "nexus/entity/entity.h"
 #include "nexus/logging.h"
 #include "nexus/types.h"
 
+#include "pxr/usd/sdf/layer.h"
 #include "pxr/usd/usd/stage.h"
 
 #include "rclcpp/executors/multi_threaded_executor.hpp"
 
+#include <atomic>
 #include <chrono>
 #include <memory>
 #include <string>
-#include <unordered_map>
+#include <thread>
 
 namespace Nexus
 {
@@ -23,6 +30,7 @@ namespace Nexus
 
     public:
         using Executor = rclcpp::executors::MultiThreadedExecutor;
+        using EntityHandle = SlotMap<std::shared_ptr<Entity>>::Handle;
 
         World() = delete;
         ~World() = delete;
@@ -46,6 +54,39 @@ namespace Nexus
             return ReadAccess(&s_Stage, &Sync::Mutex);
         }
 
+        [[nodiscard]]
+        static auto &GetStageQueue() noexcept
+        {
+            return s_Queue;
+        }
+
+        [[nodiscard]]
+        static auto GetStageStats() noexcept
+        {
+            return s_QueueStats;
+        }
+
+        /* Bumped by each drained batch that adds prims or properties, main thread only */
+        [[nodiscard]]
+        static auto GetStructureRevision() noexcept
+        {
+            return s_Structure;
+        }
+
+        /* Main thread only */
+        [[nodiscard]]
+        static auto &GetRetentionPolicy() noexcept
+        {
+            return s_Retention.Settings;
+        }
+
+        /* Main thread only */
+        [[nodiscard]]
+        static auto &GetReductionTolerance() noexcept
+        {
+            return s_Tolerance;
+        }
+
         [[nodiscard]]
         static auto CreateDefaultStage() -> pxr::UsdStageRefPtr;
 
@@ -53,39 +94,95 @@ namespace Nexus
 
         static void OpenStage(const std::string &path);
 
+        /* Saves a snapshot of the root layer on a worker thread */
         static void SaveStage();
 
+        /* Exports a flattened snapshot of the stage on a worker thread */
         static void ExportStage(const std::string &path);
 
+        [[nodiscard]]
+        static bool IsSaving() noexcept
+        {
+            return s_Saving;
+        }
+
+        static void StartRecording(const std::string &path);
+
+        static void StopRecording();
+
+        [[nodiscard]]
+        static bool IsRecording() noexcept
+        {
+            return s_Recorder.is_recording();
+        }
+
+        /* Apply the newest entity data and queued edits to the stage once per frame */
+        static void Update();
+
         static void SetExecutor(Executor *executor)
         {
             s_Executor = executor;
         }
 
         template <typename T, typename... Args>
-        static void AddEntity(void *key, Args &&...args)
+        static EntityHandle AddEntity(Args &&...args)
         {
-            LOG_EVENT("Adding entity of type <{}> at {}", typeid(T).name(), key);
+            LOG_EVENT("Adding entity of type <{}>", typeid(T).name());
             static_assert(std::is_base_of_v<Entity, T>, "Must be an Entity type");
 
-            if (s_Entities.contains(key))
+            std::shared_ptr<Entity> entity = std::make_shared<T>(std::forward<Args>(args)...);
+            entity->initialize();
+            s_Executor->add_node(entity);
+            s_Scheduler.add(entity);
+
+            return s_Entities.emplace(std::move(entity));
+        }
+
+        static void RemoveEntity(EntityHandle handle)
+        {
+            LOG_EVENT("Removing entity at slot {}", handle.Index);
+            auto *entity = s_Entities.get(handle);
+
+            if (entity == nullptr)
             {
-                LOG_ERROR("Entity at {} already exists!", key);
+                LOG_ERROR("Entity at slot {} does not exist!", handle.Index);
                 return;
             }
-            s_Entities.emplace(key, new T(std::forward<Args>(args)...));
-            s_Entities.at(key)->initialize();
-            s_Executor->add_node(s_Entities.at(key));
+            s_Scheduler.remove(*entity);
+            s_Executor->remove_node(*entity);
+            s_Entities.erase(handle);
         }
 
-        static void RemoveEntity(void *key)
+        /* Main thread only */
+        [[nodiscard]]
+        static const auto &GetEntities() noexcept
         {
-            LOG_EVENT("Removing entity at {}", key);
-            rclcpp::Node::SharedPtr node = s_Entities.at(key);
-            s_Executor->remove_node(node);
-            s_Entities.erase(key);
+            return s_Entities;
         }
 
+        [[nodiscard]]
+        static auto &GetScheduler() noexcept
+        {
+            return s_Scheduler;
+        }
+
+    private:
+        struct Snapshot
+        {
+            pxr::SdfLayerRefPtr Root;
+
+            /* Set to flatten the stage on the writer thread, like `UsdStage::Export` */
+            pxr::SdfLayerRefPtr Session;
+
+            /* Real path of the root layer, relative asset paths in `Root` are anchored to it */
+            std::string Anchor;
+        };
+
+        /* Copy the root layer, and the session layer to flatten, must hold the stage lock */
+        static auto TakeSnapshot(bool flatten) -> Snapshot;
+
+        static void WriteSnapshot(Snapshot snapshot, const std::string &path);
+
     private:
         /* Start time since static initialization */
         static inline const auto START = std::chrono::steady_clock::now();
@@ -98,8 +195,33 @@ namespace Nexus
 
         static inline pxr::UsdStageRefPtr s_Stage = World::CreateDefaultStage();
 
-        static inline std::unordered_map<void *, std::shared_ptr<Entity>> s_Entities;
+        static inline SlotMap<std::shared_ptr<Entity>> s_Entities;
+
+        /* Edits waiting for the next `Update` */
+        static inline StageQueue s_Queue;
+
+        /* Result of the last drain */
+        static inline StageQueue::Stats s_QueueStats;
+
+        /* See `GetStructureRevision` */
+        static inline std::size_t s_Structure = 0;
+
+        /* Bounds the time samples authored through `s_Queue` */
+        static inline Retention s_Retention;
+
+        /* Streams the time samples authored through `s_Queue` to disk */
+        static inline Recorder s_Recorder;
+
+        /* Keyframe reduction applied to recordings and saves */
+        static inline Reduction::Tolerance s_Tolerance;
+
+        /* Writes snapshots for `SaveStage` and `ExportStage` */
+        static inline std::jthread s_Saver;
+        static inline std::atomic<bool> s_Saving = false;
 
         static inline Executor *s_Executor = nullptr;
+
+        /* Ticks `s_Entities` off the main thread */
+        static inline Scheduler s_Scheduler;
     };
 }
\ No newline at end of file
@@ -1,17 +1,22 @@
 #pragma once
 
-#include "nexus/core/sync.h"
 #include "nexus/types.h"
 
 #include "rclcpp/node.hpp"
 
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <span>
 #include <string>
 
 namespace Nexus
 {
     class Entity : public rclcpp::Node
     {
+        friend class Scheduler;
+        friend class World;
+
     protected:
         struct Data
         {
@@ -21,6 +26,8 @@ namespace Nexus
     public:
         Entity(const std::string &name) : rclcpp::Node(name) {}
 
+        Entity(const std::string &name, const std::string &ns) : rclcpp::Node(name, ns) {}
+
         virtual ~Entity() = default;
 
         void initialize()
@@ -28,24 +35,55 @@ namespace Nexus
             m_Data = std::unique_ptr<Data>(_create_data());
         }
 
+        /* Smoothed cost of `_tick` in milliseconds */
+        [[nodiscard]]
+        double get_cost() const noexcept { return m_Cost; }
+
     protected:
         virtual Data *_create_data() = 0;
 
-        template <typename T>
-        auto _get_write_access()
+        /* Called at a fixed rate by `Scheduler` on a worker thread, must not touch the stage */
+        virtual void _tick() {}
+
+        /* Entities returning the same key are ticked together by one call to
+           `_tick_batch` instead of `_tick` each, none are if it is null */
+        [[nodiscard]]
+        virtual const void *_batch_key() const noexcept { return nullptr; }
+
+        /* Called like `_tick` on one entity of a batch with all of them, itself included */
+        virtual void _tick_batch(std::span<const std::shared_ptr<Entity>>) {}
+
+        /* Called once per frame by `World` on the main thread without the stage
+           locked, so it must only edit the stage through `World::GetStageQueue` */
+        virtual void _update(Data *) {}
+
+    private:
+        void tick()
         {
-            static_assert(std::is_base_of_v<Data, T>, "Must be an Entity::Data type");
-            return WriteAccess(static_cast<T *>(m_Data.get()), &Sync::Mutex);
+            const auto start = std::chrono::steady_clock::now();
+            _tick();
+            const std::chrono::duration<double, std::milli> cost = std::chrono::steady_clock::now() - start;
+            m_Cost = m_Cost + 0.1 * (cost.count() - m_Cost);
         }
 
-        template <typename T>
-        auto _get_read_access()
+        /* The cost of a batch is shared evenly by its entities */
+        void tick_batch(std::span<const std::shared_ptr<Entity>> entities)
         {
-            static_assert(std::is_base_of_v<Data, T>, "Must be an Entity::Data type");
-            return ReadAccess(static_cast<T *>(m_Data.get()), &Sync::Mutex);
+            const auto start = std::chrono::steady_clock::now();
+            _tick_batch(entities);
+            const std::chrono::duration<double, std::milli> cost = std::chrono::steady_clock::now() - start;
+
+            for (const auto &entity : entities)
+                entity->m_Cost = entity->m_Cost + 0.1 * (cost.count() / entities.size() - entity->m_Cost);
         }
 
+        void update() { _update(m_Data.get()); }
+
     private:
+        /* Only touched by `update` on the main thread */
         std::unique_ptr<Data> m_Data;
+
+        /* Written by one pool worker at a time */
+        std::atomic<double> m_Cost = 0.0;
     };
 }
\ No newline at end of file
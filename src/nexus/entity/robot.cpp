@@ -3,256 +3,338 @@
 #include "nexus/core/world.h"
 #include "nexus/exception.h"
 
-#include "pxr/usd/usdGeom/cube.h"
-#include "pxr/usd/usdGeom/cylinder.h"
-#include "pxr/usd/usdGeom/mesh.h"
-#include "pxr/usd/usdGeom/sphere.h"
-#include "pxr/usd/usdGeom/xform.h"
+#include "pxr/usd/sdf/layer.h"
 #include "pxr/base/gf/matrix4d.h"
 #include "pxr/base/gf/quatd.h"
 #include "pxr/base/gf/rotation.h"
 #include "pxr/base/gf/vec3d.h"
-
-#include "assimp/Importer.hpp"
-#include "assimp/postprocess.h"
-#include "assimp/scene.h"
+#include "pxr/base/gf/vec3f.h"
+#include "pxr/base/tf/stringUtils.h"
+#include "pxr/base/vt/array.h"
 
 #include "urdf/model.h"
 
+#include <algorithm>
 #include <chrono>
-
-GENERATE_LOG_FUNCTIONS(URDF_to_USD)
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <string_view>
+#include <vector>
 
 // TODO: My god this is so complex
 
-void CreateMesh(const aiScene *scene, const aiNode *node, const pxr::SdfPath &path, pxr::UsdStageRefPtr stage)
+Nexus::Robot::Robot(const std::string &urdf_path, const std::string &ns)
+    : Entity("robot", ns), c_URDF_Path(urdf_path)
 {
-    auto nodePath = path.AppendChild(pxr::TfToken(node->mName.C_Str()));
-    auto nodeXform = pxr::UsdGeomXform::Define(stage, nodePath);
+    // Follow the robot_state_publisher convention of "<namespace>/<link>"
+    const std::string name = this->get_namespace() + 1;
+    m_Prefix = this->declare_parameter<std::string>("frame_prefix", name.empty() ? "" : name + '/');
+    m_Source = this->declare_parameter<std::string>("pose_source", "tf");
 
-    pxr::GfMatrix4d pxrTransform(
-        node->mTransformation.a1, node->mTransformation.a2, node->mTransformation.a3, node->mTransformation.a4,
-        node->mTransformation.b1, node->mTransformation.b2, node->mTransformation.b3, node->mTransformation.b4,
-        node->mTransformation.c1, node->mTransformation.c2, node->mTransformation.c3, node->mTransformation.c4,
-        node->mTransformation.d1, node->mTransformation.d2, node->mTransformation.d3, node->mTransformation.d4);
-    pxrTransform.Orthonormalize();
-    // pxrTransform.SetScale(100.f);
+    if (m_Source == "joint_states")
+    {
+        m_Joints = this->create_subscription<Joint_State>("joint_states", rclcpp::QoS(10),
+                                                          [this](const Joint_State &message)
+                                                          { _on_joint_states(message); });
+        return;
+    }
 
-    nodeXform.AddTransformOp().Set(pxrTransform);
-    // usdMesh.AddScaleOp().Set(0.001f);
+    if (m_Source != "tf")
+        LOG_ALERT("Unknown pose source '{}'... using tf", m_Source);
 
-    for (int i = 0; i < node->mNumMeshes; i++)
+    auto callback = [this](const TF_Message &message)
     {
-        const aiMesh *mesh = scene->mMeshes[node->mMeshes[i]];
-        std::string meshName = mesh->mName.C_Str();
-        std::replace(meshName.begin(), meshName.end(), '-', '_');
+        _on_transforms(message);
+    };
 
-        if (meshName != mesh->mName.C_Str())
-        {
-            LOG_BASIC_URDF_to_USD("Sanitized mesh name from '{}' to '{}'", mesh->mName.C_Str(), meshName);
-        }
-        else
+    // Relative, so each namespaced robot only receives its own transforms
+    m_Dynamic = this->create_subscription<TF_Message>("tf", rclcpp::QoS(100), callback);
+    m_Static = this->create_subscription<TF_Message>("tf_static", rclcpp::QoS(100).transient_local(), callback);
+}
+
+void Nexus::Robot::_on_transforms(const TF_Message &message)
+{
+    const auto &links = m_Chain.links();
+    std::scoped_lock lock(m_Input);
+
+    for (const auto &stamped : message.transforms)
+    {
+        std::string_view frame = stamped.child_frame_id;
+
+        if (frame.starts_with(m_Prefix))
+            frame.remove_prefix(m_Prefix.size());
+
+        const auto index = m_Chain.find_link(frame);
+
+        if (index == Chain::NONE || links[index].Parent < 0)
+            continue;
+
+        // The local transform is only meaningful relative to the URDF parent
+        std::string_view parent = stamped.header.frame_id;
+
+        if (parent.starts_with(m_Prefix))
+            parent.remove_prefix(m_Prefix.size());
+
+        if (parent != links[links[index].Parent].Name)
         {
-            LOG_BASIC_URDF_to_USD("Got mesh {}", meshName);
+            RCLCPP_WARN_THROTTLE(this->get_logger(), *this->get_clock(), 1000,
+                                 "Ignoring transform of '%s' from '%s', expected parent '%s'",
+                                 links[index].Name.c_str(), stamped.header.frame_id.c_str(),
+                                 links[links[index].Parent].Name.c_str());
+            continue;
         }
 
-        pxr::VtArray<pxr::GfVec3f> points(mesh->mNumVertices);
-        pxr::VtArray<pxr::GfVec3f> normals(mesh->mNumVertices);
-        pxr::VtArray<int> faceVertexCounts(mesh->mNumFaces);
-        pxr::VtArray<int> faceVertexIndices(mesh->mNumFaces * 3);
+        const auto &rotation = stamped.transform.rotation;
+        const auto &translation = stamped.transform.translation;
+        pxr::GfQuatd q(rotation.w, rotation.x, rotation.y, rotation.z);
+        pxr::GfVec3d t(translation.x, translation.y, translation.z);
+
+        auto &state = m_Tree[index];
+        state.Local = pxr::GfMatrix4d(q, t);
+        state.Known = true;
+        state.Dirty = true;
+
+        m_Changed = true;
+        m_Time = World::GetTime();
+        m_Stamp = std::max(m_Stamp, rclcpp::Time(stamped.header.stamp).seconds());
+    }
+}
+
+void Nexus::Robot::_on_joint_states(const Joint_State &message)
+{
+    std::scoped_lock lock(m_Input);
+
+    // Publishers keep the same joint order, so only re-resolve on change
+    if (message.name != m_Names)
+    {
+        m_Names = message.name;
+        m_Order.resize(m_Names.size());
+
+        for (std::size_t i = 0; i < m_Names.size(); ++i)
+            m_Order[i] = m_Chain.find_joint(m_Names[i]);
+    }
+
+    const auto count = std::min(m_Order.size(), message.position.size());
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (m_Order[i] != Chain::NONE)
+            m_Positions[m_Order[i]] = message.position[i];
+    }
+
+    m_Changed = true;
+    m_Time = World::GetTime();
+    m_Stamp = rclcpp::Time(message.header.stamp).seconds();
+}
+
+void Nexus::Robot::_tick()
+{
+    // Only robots driven by TF get here, the others are solved by `_tick_batch`
+    std::scoped_lock lock(m_Input);
+
+    if (!m_Changed)
+        return;
+
+    m_Changed = false;
 
-        for (int i = 0; i < points.size(); i++)
+    const auto &links = m_Chain.links();
+
+    // Parents come first so each subtree is recomputed once
+    for (std::size_t i = 0; i < links.size(); ++i)
+    {
+        if (links[i].Parent < 0)
+            continue;
+
+        auto &frame = m_Tree[i];
+        const auto &parent = m_Tree[links[i].Parent];
+        frame.Ready = frame.Known && parent.Ready;
+        frame.Dirty = frame.Dirty || parent.Dirty;
+
+        if (frame.Dirty && frame.Ready)
+            frame.Global = frame.Local * parent.Global;
+    }
+
+    for (auto &frame : m_Tree)
+        frame.Dirty = false;
+
+    for (const auto index : m_Posed)
+    {
+        if (!m_Tree[index].Ready)
         {
-            points[i] = pxr::GfVec3f(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z);
-            normals[i] = pxr::GfVec3f(mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z);
+            RCLCPP_WARN_THROTTLE(this->get_logger(), *this->get_clock(), 1000,
+                                 "Waiting for transform of '%s'", links[index].Name.c_str());
+            return;
         }
+        m_Globals[index] = m_Tree[index].Global;
+    }
 
-        for (int i = 0; i < mesh->mNumFaces; i++)
-        {
-            const aiFace &face = mesh->mFaces[i];
-            faceVertexCounts[i] = face.mNumIndices;
+    _publish();
+    m_Stamp = 0.0;
+}
 
-            for (int j = 0; j < face.mNumIndices; j++)
-            {
-                faceVertexIndices[i * 3 + j] = face.mIndices[j];
-            }
-        }
+void Nexus::Robot::_tick_batch(std::span<const std::shared_ptr<Entity>> entities)
+{
+    auto &kinematics = *m_Kinematics;
+    auto &changed = kinematics.Changed;
+    changed.clear();
+
+    // Lanes follow the order of the batch, which only changes when robots come or go
+    if (!kinematics.Lanes || kinematics.Lanes->size() != entities.size())
+        kinematics.Lanes.emplace(kinematics.Model, entities.size());
+
+    auto &fleet = *kinematics.Lanes;
+
+    for (std::size_t r = 0; r < entities.size(); ++r)
+    {
+        auto &robot = static_cast<Robot &>(*entities[r]);
+        std::scoped_lock lock(robot.m_Input);
+
+        if (!robot.m_Changed)
+            continue;
 
-        auto usdMesh = pxr::UsdGeomMesh::Define(stage, nodePath.AppendChild(pxr::TfToken(meshName)));
-        usdMesh.CreatePointsAttr(pxr::VtValue(points));
-        usdMesh.CreateNormalsAttr(pxr::VtValue(normals));
-        usdMesh.CreateFaceVertexCountsAttr(pxr::VtValue(faceVertexCounts));
-        usdMesh.CreateFaceVertexIndicesAttr(pxr::VtValue(faceVertexIndices));
-        LOG_BASIC_URDF_to_USD("Defined USD mesh at {}", usdMesh.GetPath().GetString());
+        robot.m_Changed = false;
+        fleet.set_positions(r, robot.m_Positions.data());
+        changed.push_back(r);
     }
 
-    for (int i = 0; i < node->mNumChildren; i++)
+    if (changed.empty())
+        return;
+
+    fleet.solve();
+
+    for (const auto r : changed)
     {
-        CreateMesh(scene, node->mChildren[i], nodePath, stage);
+        auto &robot = static_cast<Robot &>(*entities[r]);
+        std::scoped_lock lock(robot.m_Input);
+
+        for (const auto index : robot.m_Posed)
+            robot.m_Globals[index] = fleet.pose(r, index);
+
+        robot._publish();
     }
 }
 
-Nexus::Robot::Robot(const std::string &urdf_path) : Entity("robot"), c_URDF_Path(urdf_path)
+void Nexus::Robot::_publish()
 {
-    using namespace std::chrono_literals;
-    m_Buffer = std::make_unique<TF_Buffer>(this->get_clock());
-    m_Listener = std::make_shared<TF_Listener>(*m_Buffer);
-    m_Timer = this->create_wall_timer(
-        3ms, [this]()
-        {
-            try
-            {
-                auto time = World::GetTime();
-                auto data = _get_write_access<Data>();
-
-                for (auto &[name, xform] : *data)
-                {
-                    const auto look = m_Buffer->lookupTransform("base", name.c_str(), tf2::TimePointZero);
-                    const auto &rotation = look.transform.rotation;
-                    const auto &translation = look.transform.translation;
-                    pxr::GfQuatd q(rotation.w, rotation.x, rotation.y, rotation.z);
-                    pxr::GfVec3d t(translation.x, translation.y, translation.z);
-                    pxr::GfMatrix4d m(q, t);
-                    xform.Set(m, time);
-                }
-            }
-            catch (const tf2::TransformException &e)
-            {
-                RCLCPP_ERROR_THROTTLE(this->get_logger(), *this->get_clock(), 1000, e.what());
-            } });
+    auto &pose = m_Poses.back();
+    pose.Time = m_Time;
+    pose.Stamp = m_Stamp;
+    pose.Transforms.resize(m_Posed.size());
+
+    for (std::size_t i = 0; i < m_Posed.size(); ++i)
+        pose.Transforms[i] = m_Globals[m_Posed[i]];
+
+    m_Poses.publish();
 }
 
-Nexus::Entity::Data *Nexus::Robot::_create_data()
+void Nexus::Robot::_update(Entity::Data *data)
 {
-    urdf::Model model;
+    auto &queue = World::GetStageQueue();
 
-    if (!model.initFile(c_URDF_Path))
-        throw exception("Error parsing URDF at {}", c_URDF_Path);
+    if (m_Prototype.Layer.valid())
+    {
+        if (m_Prototype.Layer.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            return;
 
-    LOG_EVENT("Parsed URDF with robot name {}", model.name_);
-    const pxr::SdfPath root('/' + model.name_);
+        // Copied rather than referenced so saved stages do not point at anonymous layers
+        queue.copy(m_Root, m_Prototype.Layer.get(), m_Prototype.Path);
+        m_Prototype = {};
+    }
 
-    auto *data = new Data();
-    auto &xforms = *data;
-    xforms.clear();
+    if (!m_Poses.fetch())
+        return;
 
-    auto stage = World::GetStageWriteAccess();
+    auto &links = *static_cast<Data *>(data);
+    const auto &pose = m_Poses.front();
 
-    for (const auto &[name, link] : model.links_)
+    if (pose.Stamp > 0.0)
     {
-        const pxr::SdfPath linkPath = root.AppendChild(pxr::TfToken(name));
-        auto xform = pxr::UsdGeomXform::Define(*stage, linkPath);
+        const double latency = (this->now().seconds() - pose.Stamp) * 1000.0;
+        LATENCY += 0.1 * (latency - LATENCY);
+    }
 
-        LOG_BASIC("Got link '{}'", name);
+    for (std::size_t i = 0; i < pose.Transforms.size(); ++i)
+    {
+        const auto &transform = pose.Transforms[i];
+        auto &authored = links.Authored[i];
+        auto &skipped = links.Skipped[i];
 
-        if (!link)
+        if (DEADBAND.Enabled && authored.Valid &&
+            Reduction::Within(transform, authored.Transform, DEADBAND))
         {
-            LOG_BASIC("Link was null... skipping");
+            skipped = {pose.Time, transform, true};
+            SKIPPED++;
             continue;
         }
-        const urdf::VisualSharedPtr &visual = link->visual;
 
-        if (!visual)
-        {
-            LOG_BASIC("Visual was null... skipping");
-            continue;
-        }
-        const urdf::GeometrySharedPtr &geometry = visual->geometry;
+        const auto &path = links.Paths[i];
 
-        if (!geometry)
+        // Close the still segment so playback does not
+        // interpolate across it once the link moves again
+        if (skipped.Valid)
         {
-            LOG_BASIC("Geometry was null... skipping");
-            continue;
+            queue.set(path, pxr::VtValue(skipped.Transform), skipped.Time);
+            skipped.Valid = false;
+            WRITTEN++;
         }
 
-        /* Apply visual offset */
-        // TODO: right order?
-        xform.AddTranslateOp().Set(pxr::GfVec3d(visual->origin.position.x,
-                                                visual->origin.position.y,
-                                                visual->origin.position.z));
-        xform.AddOrientOp().Set(pxr::GfQuatf(visual->origin.rotation.w,
-                                             visual->origin.rotation.x,
-                                             visual->origin.rotation.y,
-                                             visual->origin.rotation.z));
-        xforms[name] = xform.AddTransformOp();
-
-        switch (geometry->type)
-        {
-        case urdf::Geometry::BOX:
-        {
-            // auto box = std::static_pointer_cast<urdf::Box>(geometry);
-            // auto cube = pxr::UsdGeomCube::Define(stage, root.AppendChild(pxr::TfToken(name)));
-            // cube.CreateSizeAttr(pxr::VtValue(box->dim.x)); // FIXME: cube only has a size
-            // cube.CreateDisplayColorPrimvar().Set(pxr::VtArray(pxr::GfVec3f(0.5, 0.5, 0.5)));
-            // _XformOps[name] = cube.AddTransformOp();
-            LOG_ALERT("Box geometry is not supported");
-            break;
-        }
-        case urdf::Geometry::CYLINDER:
-        {
-            // auto cylinder = std::static_pointer_cast<urdf::Cylinder>(geometry);
-            // auto usd_cylinder = pxr::UsdGeomCylinder::Define(stage, root.AppendChild(pxr::TfToken(name)));
-            // usd_cylinder.CreateHeightAttr(pxr::VtValue(cylinder->length));
-            // usd_cylinder.CreateRadiusAttr(pxr::VtValue(cylinder->radius));
-            // usd_cylinder.CreateDisplayColorPrimvar().Set(pxr::VtArray(pxr::GfVec3f(0.5, 0.5, 0.5)));
-            // _XformOps[name] = usd_cylinder.AddTransformOp();
-            LOG_ALERT("Cylinder geometry is not supported");
-            break;
-        }
-        case urdf::Geometry::MESH:
-        {
-            const auto &urdfMesh = std::static_pointer_cast<urdf::Mesh>(geometry);
-
-            Assimp::Importer importer;
-
-            importer.SetPropertyFloat(AI_CONFIG_GLOBAL_SCALE_FACTOR_KEY, 0.001f);
-
-            const int pFlags = aiProcess_CalcTangentSpace |
-                               aiProcess_Triangulate |
-                               aiProcess_JoinIdenticalVertices |
-                               aiProcess_SortByPType |
-                               aiProcess_GlobalScale;
-            const aiScene *scene = importer.ReadFile(urdfMesh->filename.c_str(), pFlags);
-
-            if (scene == nullptr)
-            {
-                LOG_BASIC("Could not import mesh at {}", urdfMesh->filename);
-                break;
-            }
-            LOG_BASIC("Imported mesh at {}", urdfMesh->filename);
-
-            if (scene->mNumMeshes == 0)
-            {
-                LOG_BASIC("Mesh was empty... skipping");
-                break;
-            }
-
-            for (int i = 0; i < scene->mRootNode->mNumChildren; i++)
-            {
-                const aiNode *child = scene->mRootNode->mChildren[i];
-                if (child->mNumMeshes > 0)
-                {
-                    LOG_BASIC("Found mesh node '{}'", child->mName.C_Str());
-                    CreateMesh(scene, child, linkPath, *stage);
-                }
-            }
-            // CreateMesh(scene, scene->mRootNode, linkPath, stage);
-            break;
-        }
-        case urdf::Geometry::SPHERE:
+        queue.set(path, pxr::VtValue(transform), pose.Time);
+        authored = {pose.Time, transform, true};
+        WRITTEN++;
+    }
+}
+
+Nexus::Entity::Data *Nexus::Robot::_create_data()
+{
+    auto model = std::make_shared<urdf::Model>();
+
+    if (!model->initFile(c_URDF_Path))
+        throw exception("Error parsing URDF at {}", c_URDF_Path);
+
+    LOG_EVENT("Parsed URDF with robot name {}", model->name_);
+    // Namespaced robots are rooted at their namespace so several can share a URDF
+    const std::string ns = this->get_namespace() + 1;
+    m_Root = pxr::SdfPath('/' + (ns.empty() ? model->name_ : pxr::TfMakeValidIdentifier(ns)));
+
+    auto *data = new Data();
+    m_Posed.clear();
+
+    // Poses are relative to the root link
+    m_Chain = Chain(*model);
+    m_Tree.assign(m_Chain.links().size(), {});
+    m_Tree.front().Known = true;
+    m_Tree.front().Ready = true;
+    m_Positions.assign(m_Chain.joints().size(), 0.0);
+    m_Globals.assign(m_Chain.links().size(), pxr::GfMatrix4d(1));
+
+    // Robots driven by joint states share one batched solve per version of the URDF
+    if (m_Joints)
+    {
+        std::error_code error;
+        const auto time = std::filesystem::last_write_time(c_URDF_Path, error);
+        auto &shared = s_Kinematics[c_URDF_Path];
+        m_Kinematics = shared.lock();
+
+        if (!m_Kinematics || m_Kinematics->Time != time)
         {
-            // auto sphere = std::static_pointer_cast<urdf::Sphere>(geometry);
-            // auto usd_sphere = pxr::UsdGeomSphere::Define(stage, root.AppendChild(pxr::TfToken(name)));
-            // usd_sphere.CreateRadiusAttr(pxr::VtValue(sphere->radius));
-            // usd_sphere.CreateDisplayColorPrimvar().Set(pxr::VtArray(pxr::GfVec3f(0.5, 0.5, 0.5)));
-            // _XformOps[name] = usd_sphere.AddTransformOp();
-            LOG_ALERT("Sphere geometry is not supported");
-            break;
-        }
-        default:
-            LOG_ERROR("Unknown geometry type!");
+            m_Kinematics = std::make_shared<Kinematics>(time, m_Chain);
+            shared = m_Kinematics;
         }
     }
-    LOG_EVENT("Converted URDF to USD with {} links", xforms.size());
+
+    for (const auto &[name, link] : model->links_)
+    {
+        if (!link || !UrdfImport::HasGeometry(*link))
+            continue;
+
+        data->Paths.push_back(UrdfImport::PosePath(m_Root, name));
+        m_Posed.push_back(m_Chain.find_link(name));
+    }
+    data->Authored.resize(m_Posed.size());
+    data->Skipped.resize(m_Posed.size());
+
+    // Prims are authored off the stage, once per URDF, and attached by `_update` once ready
+    m_Prototype = UrdfImport::GetPrototype(c_URDF_Path, model);
     return data;
 }
\ No newline at end of file
@@ -1,44 +1,190 @@
 #pragma once
 
+#include "nexus/convert/urdf_import.h"
+#include "nexus/core/reduction.h"
 #include "nexus/entity/entity.h"
+#include "nexus/kinematics/chain.h"
+#include "nexus/kinematics/fleet.h"
 #include "nexus/logging.h"
+#include "nexus/types.h"
 
-#include "pxr/usd/usdGeom/xformOp.h"
+#include "pxr/base/gf/matrix4d.h"
+#include "pxr/usd/sdf/layer.h"
+#include "pxr/usd/sdf/path.h"
 
-#include "rclcpp/timer.hpp"
+#include "rclcpp/subscription.hpp"
 #include "sensor_msgs/msg/joint_state.hpp"
+#include "tf2_msgs/msg/tf_message.hpp"
 
-#include "tf2_ros/buffer.h"
-#include "tf2_ros/transform_listener.h"
-
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace Nexus
 {
     class Robot : public Entity, LOGGER(Robot)
     {
-        struct Data
-            : public Entity::Data,
-              std::unordered_map<std::string, pxr::UsdGeomXformOp>
+        /* A transform at a point in time */
+        struct Sample
+        {
+            double Time = 0.0;
+            pxr::GfMatrix4d Transform;
+            bool Valid = false;
+        };
+
+        /* Per posed link, packed in the same order as `m_Posed` */
+        struct Data : public Entity::Data
+        {
+            /* Path of the transform op each pose is authored to */
+            std::vector<pxr::SdfPath> Paths;
+
+            /* Last sample authored */
+            std::vector<Sample> Authored;
+
+            /* Newest sample skipped by the deadband */
+            std::vector<Sample> Skipped;
+        };
+
+        /* Link transforms looked up at one point in time */
+        struct Pose
         {
+            double Time = 0.0;
+
+            /* ROS time of the newest message, to measure latency */
+            double Stamp = 0.0;
+            std::vector<pxr::GfMatrix4d> Transforms;
         };
 
-        using Timer = rclcpp::TimerBase;
-        using TF_Buffer = tf2_ros::Buffer;
-        using TF_Listener = tf2_ros::TransformListener;
+        /* Latest TF state of a link in `m_Chain` */
+        struct Frame
+        {
+            /* Parent to link, and root to link */
+            pxr::GfMatrix4d Local = pxr::GfMatrix4d(1);
+            pxr::GfMatrix4d Global = pxr::GfMatrix4d(1);
+
+            /* Local has been received, and so has every local above it */
+            bool Known = false;
+            bool Ready = false;
+
+            /* Changed since the last tick */
+            bool Dirty = false;
+        };
+
+        /* Forward kinematics of the robots of a URDF driven by joint states,
+           solved for all of them at once by `_tick_batch` */
+        struct Kinematics
+        {
+            /* Modification time of the URDF `Model` was parsed from */
+            std::filesystem::file_time_type Time;
+            Chain Model;
+
+            /* One lane per robot of the batch, rebuilt when their number changes */
+            std::optional<Fleet> Lanes;
+
+            /* Lanes with new positions this tick, reused between ticks */
+            std::vector<std::size_t> Changed;
+        };
+
+        using TF_Message = tf2_msgs::msg::TFMessage;
+        using TF_Subscription = rclcpp::Subscription<TF_Message>;
+        using Joint_State = sensor_msgs::msg::JointState;
+        using Joint_Subscription = rclcpp::Subscription<Joint_State>;
 
     public:
-        Robot(const std::string &urdf_path);
+        ///
+        /// @param urdf_path URDF file of the robot
+        /// @param ns Node namespace, also the frame prefix and the USD root prim if not empty
+        ///
+        Robot(const std::string &urdf_path, const std::string &ns = "");
+
+    public:
+        /* Poses closer than this to the last authored pose are skipped */
+        static inline Reduction::Tolerance DEADBAND = {.Enabled = true, .Position = 0.0001, .Angle = 0.01};
+
+        /* Samples authored and skipped by all robots */
+        static inline std::size_t WRITTEN = 0;
+        static inline std::size_t SKIPPED = 0;
+
+        /* Smoothed delay from message stamp to stage edit in milliseconds */
+        static inline double LATENCY = 0.0;
 
     protected:
         Entity::Data *_create_data() override;
 
+        void _tick() override;
+
+        [[nodiscard]]
+        const void *_batch_key() const noexcept override { return m_Kinematics.get(); }
+
+        void _tick_batch(std::span<const std::shared_ptr<Entity>> entities) override;
+
+        void _update(Entity::Data *data) override;
+
+    private:
+        void _on_transforms(const TF_Message &message);
+
+        void _on_joint_states(const Joint_State &message);
+
+        /* Publish `m_Globals` of the posed links, must hold `m_Input` */
+        void _publish();
+
     private:
         const std::string c_URDF_Path;
 
-        std::shared_ptr<Timer> m_Timer;
-        std::unique_ptr<TF_Buffer> m_Buffer;
-        std::shared_ptr<TF_Listener> m_Listener;
+        /* Stripped from TF frame IDs, e.g. "robot_1/" */
+        std::string m_Prefix;
+
+        /* Root prim, fixed after `_create_data` */
+        pxr::SdfPath m_Root;
+
+        /* Shared with other robots of the URDF, copied to `m_Root` by `_update` once built */
+        UrdfImport::Prototype m_Prototype;
+
+        /* Index in `m_Chain` of each link with geometry, fixed after `_create_data` */
+        std::vector<std::size_t> m_Posed;
+
+        /* Joint tree of the URDF, fixed after `_create_data` */
+        Chain m_Chain;
+
+        /* Either "tf" or "joint_states" */
+        std::string m_Source;
+
+        /* Shared by the robots of `c_URDF_Path` driven by joint states, null otherwise */
+        std::shared_ptr<Kinematics> m_Kinematics;
+
+        /* Per URDF path, main thread only */
+        static inline std::unordered_map<std::string, std::weak_ptr<Kinematics>> s_Kinematics;
+
+        /* Guards the members below, written by the subscriptions and read by `_tick` */
+        std::mutex m_Input;
+
+        /* Received since the last tick, at this time and with this stamp */
+        bool m_Changed = false;
+        double m_Time = 0.0;
+        double m_Stamp = 0.0;
+
+        /* TF state of each link in `m_Chain` */
+        std::vector<Frame> m_Tree;
+
+        /* Joint names of the last message and their index in `m_Chain` */
+        std::vector<std::string> m_Names;
+        std::vector<std::size_t> m_Order;
+
+        /* Joint positions and link poses, reused between messages */
+        std::vector<double> m_Positions;
+        std::vector<pxr::GfMatrix4d> m_Globals;
+
+        /* Written by `_tick`, read by the main thread */
+        TripleBuffer<Pose> m_Poses;
+
+        std::shared_ptr<TF_Subscription> m_Dynamic;
+        std::shared_ptr<TF_Subscription> m_Static;
+        std::shared_ptr<Joint_Subscription> m_Joints;
     };
 }
\ No newline at end of file
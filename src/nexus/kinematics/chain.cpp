@@ -0,0 +1,137 @@
+#include "chain.h"
+
+#include "pxr/base/gf/quatd.h"
+#include "pxr/base/gf/rotation.h"
+
+#include <numbers>
+
+static pxr::GfMatrix4d ToMatrix(const urdf::Pose &pose)
+{
+    const auto &r = pose.rotation;
+    const auto &p = pose.position;
+    return pxr::GfMatrix4d(pxr::GfRotation(pxr::GfQuatd(r.w, r.x, r.y, r.z)), pxr::GfVec3d(p.x, p.y, p.z));
+}
+
+Nexus::Chain::Chain(const urdf::ModelInterface &model)
+{
+    std::vector<urdf::LinkConstSharedPtr> stack = {model.getRoot()};
+
+    while (!stack.empty())
+    {
+        const auto link = stack.back();
+        stack.pop_back();
+
+        Link &node = m_Links.emplace_back();
+        node.Name = link->name;
+
+        if (const auto parent = link->getParent())
+            node.Parent = static_cast<int>(m_LinkLookup.at(parent->name));
+
+        m_LinkLookup.emplace(link->name, m_Links.size() - 1);
+
+        if (const auto &joint = link->parent_joint)
+        {
+            node.Joint = joint->name;
+            node.Origin = ToMatrix(joint->parent_to_joint_origin_transform);
+            node.Axis = pxr::GfVec3d(joint->axis.x, joint->axis.y, joint->axis.z);
+
+            switch (joint->type)
+            {
+            case urdf::Joint::REVOLUTE:
+            case urdf::Joint::CONTINUOUS:
+                node.Type = Motion::REVOLUTE;
+                break;
+            case urdf::Joint::PRISMATIC:
+                node.Type = Motion::PRISMATIC;
+                break;
+            case urdf::Joint::FIXED:
+                break;
+            default:
+                LOG_ALERT("Joint '{}' is neither fixed, revolute nor prismatic... treating as fixed", joint->name);
+            }
+        }
+
+        for (const auto &child : link->child_links)
+            stack.push_back(child);
+    }
+
+    // Mimic joints reuse the position of the joint they follow
+    for (auto &link : m_Links)
+    {
+        if (link.Type == Motion::FIXED)
+            continue;
+
+        const auto &joint = model.getJoint(link.Joint);
+
+        if (joint->mimic)
+            continue;
+
+        link.Variable = static_cast<int>(m_Joints.size());
+        m_JointLookup.emplace(link.Joint, m_Joints.size());
+        m_Joints.push_back(link.Joint);
+    }
+
+    for (auto &link : m_Links)
+    {
+        if (link.Type == Motion::FIXED || link.Variable >= 0)
+            continue;
+
+        const auto &mimic = model.getJoint(link.Joint)->mimic;
+        const auto found = m_JointLookup.find(mimic->joint_name);
+
+        if (found == m_JointLookup.end())
+        {
+            LOG_ALERT("Joint '{}' mimics unknown joint '{}'... treating as fixed", link.Joint, mimic->joint_name);
+            link.Type = Motion::FIXED;
+            continue;
+        }
+        link.Variable = static_cast<int>(found->second);
+        link.Multiplier = mimic->multiplier;
+        link.Offset = mimic->offset;
+    }
+
+    LOG_EVENT("Built chain of {} links with {} joints", m_Links.size(), m_Joints.size());
+}
+
+std::size_t Nexus::Chain::find_link(std::string_view name) const noexcept
+{
+    const auto found = m_LinkLookup.find(name);
+    return found == m_LinkLookup.end() ? NONE : found->second;
+}
+
+std::size_t Nexus::Chain::find_joint(std::string_view name) const noexcept
+{
+    const auto found = m_JointLookup.find(name);
+    return found == m_JointLookup.end() ? NONE : found->second;
+}
+
+pxr::GfMatrix4d Nexus::Chain::local(std::size_t index, const double *positions) const
+{
+    const auto &link = m_Links[index];
+
+    if (link.Type == Motion::FIXED)
+        return link.Origin;
+
+    const double q = link.Multiplier * positions[link.Variable] + link.Offset;
+    pxr::GfMatrix4d motion;
+
+    if (link.Type == Motion::REVOLUTE)
+        motion.SetRotate(pxr::GfRotation(link.Axis, q * 180.0 / std::numbers::pi));
+    else
+        motion.SetTranslate(link.Axis * q);
+
+    return motion * link.Origin;
+}
+
+void Nexus::Chain::solve(const double *positions, pxr::GfMatrix4d *poses) const
+{
+    for (std::size_t i = 0; i < m_Links.size(); ++i)
+    {
+        const int parent = m_Links[i].Parent;
+
+        if (parent < 0)
+            poses[i].SetIdentity();
+        else
+            poses[i] = local(i, positions) * poses[parent];
+    }
+}
\ No newline at end of file
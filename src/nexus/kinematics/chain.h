@@ -0,0 +1,124 @@
+#pragma once
+
+#include "nexus/logging.h"
+
+#include "pxr/base/gf/matrix4d.h"
+#include "pxr/base/gf/vec3d.h"
+
+#include "urdf_model/model.h"
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Nexus
+{
+    ///
+    /// @brief The joint tree of a URDF model, flattened with parents
+    /// before children so every link pose is computed in a single pass.
+    /// Matrices follow the USD row-vector convention, i.e. a link's pose
+    /// is `motion * origin * parent`.
+    ///
+    class Chain : Logger<"Chain">
+    {
+    public:
+        enum class Motion : char
+        {
+            FIXED,
+            REVOLUTE,
+            PRISMATIC
+        };
+
+        struct Link
+        {
+            std::string Name;
+            int Parent = -1;
+
+            /* Joint connecting the link to its parent */
+            std::string Joint;
+            Motion Type = Motion::FIXED;
+
+            /* Parent link to joint frame */
+            pxr::GfMatrix4d Origin = pxr::GfMatrix4d(1);
+            pxr::GfVec3d Axis = pxr::GfVec3d(0.0, 0.0, 1.0);
+
+            /* Index into the joint positions, or -1 if the joint is fixed */
+            int Variable = -1;
+
+            /* Position is `Multiplier * positions[Variable] + Offset` */
+            double Multiplier = 1.0;
+            double Offset = 0.0;
+        };
+
+        static constexpr std::size_t NONE = static_cast<std::size_t>(-1);
+
+    public:
+        Chain() = default;
+
+        ///
+        /// @brief Flatten the joint tree of a parsed model
+        /// @param model URDF model with a root link
+        ///
+        explicit Chain(const urdf::ModelInterface &model);
+
+        ///
+        /// @brief Index of a link by name
+        /// @return Index into `links()`, or `NONE`
+        ///
+        [[nodiscard]]
+        std::size_t find_link(std::string_view name) const noexcept;
+
+        ///
+        /// @brief Index of a movable joint by name
+        /// @return Index into the joint positions, or `NONE`
+        ///
+        [[nodiscard]]
+        std::size_t find_joint(std::string_view name) const noexcept;
+
+        ///
+        /// @brief Transform of a link relative to its parent link
+        /// @param index Index into `links()`, must not be the root
+        /// @param positions One position per movable joint, in `joints()` order
+        ///
+        [[nodiscard]]
+        pxr::GfMatrix4d local(std::size_t index, const double *positions) const;
+
+        ///
+        /// @brief Compute the pose of every link relative to the root link
+        /// @param positions One position per movable joint, in `joints()` order
+        /// @param poses One pose per link, in `links()` order
+        ///
+        void solve(const double *positions, pxr::GfMatrix4d *poses) const;
+
+        [[nodiscard]]
+        const auto &links() const noexcept { return m_Links; }
+
+        /* Movable joints by variable index */
+        [[nodiscard]]
+        const auto &joints() const noexcept { return m_Joints; }
+
+    private:
+        /* Lets lookups take a `std::string_view` without building a string */
+        struct Hash
+        {
+            using is_transparent = void;
+
+            std::size_t operator()(std::string_view name) const noexcept
+            {
+                return std::hash<std::string_view>{}(name);
+            }
+        };
+
+        using Lookup = std::unordered_map<std::string, std::size_t, Hash, std::equal_to<>>;
+
+    private:
+        std::vector<Link> m_Links;
+        std::vector<std::string> m_Joints;
+
+        Lookup m_LinkLookup;
+        Lookup m_JointLookup;
+    };
+}
\ No newline at end of file
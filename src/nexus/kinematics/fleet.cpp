@@ -0,0 +1,234 @@
+#include "fleet.h"
+
+#include "pxr/base/gf/vec3d.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace
+{
+    // Lanes of the widest kernel, so every kernel sweeps whole packs
+    constexpr std::size_t WIDEST = 8;
+
+    // One double at a time, for CPUs without AVX2
+    struct Lanes
+    {
+        static constexpr std::size_t WIDTH = 1;
+
+        double V;
+
+        static Lanes Load(const double *p) noexcept { return {*p}; }
+        static Lanes Set(double x) noexcept { return {x}; }
+        void store(double *p) const noexcept { *p = V; }
+
+        static Lanes Fma(Lanes a, Lanes b, Lanes c) noexcept { return {a.V * b.V + c.V}; }
+    };
+
+    Nexus::Fleet::Kernel Detect() noexcept
+    {
+        using Kernel = Nexus::Fleet::Kernel;
+
+#if defined(_MSC_VER) && defined(_M_X64)
+        int info[4];
+        __cpuid(info, 0);
+
+        if (info[0] < 7)
+            return Kernel::SCALAR;
+
+        __cpuid(info, 1);
+        const bool fma = info[2] & (1 << 12);
+        const bool xsave = info[2] & (1 << 27);
+
+        if (!xsave)
+            return Kernel::SCALAR;
+
+        // The OS must save the wider registers on a context switch
+        const auto enabled = _xgetbv(0);
+        __cpuidex(info, 7, 0);
+
+        if ((info[1] & (1 << 16)) && (enabled & 0xE6) == 0xE6)
+            return Kernel::AVX512;
+        if ((info[1] & (1 << 5)) && fma && (enabled & 0x6) == 0x6)
+            return Kernel::AVX2;
+#elif defined(__x86_64__)
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx512f"))
+            return Kernel::AVX512;
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            return Kernel::AVX2;
+#endif
+        return Kernel::SCALAR;
+    }
+}
+
+Nexus::Fleet::Fleet(const Chain &chain, std::size_t robots, Kernel kernel)
+    : m_Kernel(std::min(kernel, Best())),
+      m_Robots(robots),
+      m_Stride((robots + WIDEST - 1) / WIDEST * WIDEST)
+{
+    static_assert(static_cast<int>(Chain::Motion::REVOLUTE) == static_cast<int>(FleetKernel::Motion::REVOLUTE) &&
+                  static_cast<int>(Chain::Motion::PRISMATIC) == static_cast<int>(FleetKernel::Motion::PRISMATIC));
+
+    const auto &links = chain.links();
+    m_Terms.resize(links.size());
+
+    for (std::size_t i = 0; i < links.size(); ++i)
+    {
+        const auto &link = links[i];
+        auto &term = m_Terms[i];
+        term.Type = static_cast<FleetKernel::Motion>(link.Type);
+        term.Parent = link.Parent;
+        term.Variable = link.Variable;
+        term.Multiplier = link.Multiplier;
+        term.Offset = link.Offset;
+
+        const auto &o = link.Origin;
+        const auto k = link.Axis.GetNormalized();
+
+        for (int j = 0; j < 3; ++j)
+            term.T[j] = o[3][j];
+
+        for (int row = 0; row < 3; ++row)
+            for (int col = 0; col < 3; ++col)
+                term.C[row * 3 + col] = o[row][col];
+
+        if (link.Type == Chain::Motion::PRISMATIC)
+        {
+            for (int col = 0; col < 3; ++col)
+                term.D[col] = k[0] * o[0][col] + k[1] * o[1][col] + k[2] * o[2][col];
+        }
+        else if (link.Type == Chain::Motion::REVOLUTE)
+        {
+            // Rotation about k as a row-vector matrix: cos * (I - kk) + sin * K + kk
+            const double kk[9] = {k[0] * k[0], k[0] * k[1], k[0] * k[2],
+                                  k[1] * k[0], k[1] * k[1], k[1] * k[2],
+                                  k[2] * k[0], k[2] * k[1], k[2] * k[2]};
+            const double skew[9] = {0.0, k[2], -k[1],
+                                    -k[2], 0.0, k[0],
+                                    k[1], -k[0], 0.0};
+
+            for (int row = 0; row < 3; ++row)
+            {
+                for (int col = 0; col < 3; ++col)
+                {
+                    double a = 0.0, b = 0.0, c = 0.0;
+
+                    for (int n = 0; n < 3; ++n)
+                    {
+                        const double identity = row == n ? 1.0 : 0.0;
+                        a += (identity - kk[row * 3 + n]) * o[n][col];
+                        b += skew[row * 3 + n] * o[n][col];
+                        c += kk[row * 3 + n] * o[n][col];
+                    }
+                    term.A[row * 3 + col] = a;
+                    term.B[row * 3 + col] = b;
+                    term.C[row * 3 + col] = c;
+                }
+            }
+        }
+    }
+
+    m_Positions.assign(chain.joints().size() * m_Stride, 0.0);
+    m_Cos.assign(links.size() * m_Stride, 1.0);
+    m_Sin.assign(links.size() * m_Stride, 0.0);
+    m_Poses.assign(links.size() * ELEMENTS * m_Stride, 0.0);
+
+    // Roots are never solved and stay at the identity
+    for (std::size_t i = 0; i < links.size(); ++i)
+    {
+        if (links[i].Parent >= 0)
+            continue;
+
+        for (const std::size_t e : {0, 4, 8})
+            std::fill_n(&m_Poses[(i * ELEMENTS + e) * m_Stride], m_Stride, 1.0);
+    }
+
+    LOG_EVENT("Allocated {} robots of {} links using the {} kernel", robots, links.size(), Name(m_Kernel));
+}
+
+void Nexus::Fleet::set_positions(std::size_t robot, const double *positions) noexcept
+{
+    const std::size_t count = m_Positions.size() / m_Stride;
+
+    for (std::size_t v = 0; v < count; ++v)
+        m_Positions[v * m_Stride + robot] = positions[v];
+}
+
+void Nexus::Fleet::solve() noexcept
+{
+    // Trigonometry is done up front so the kernel below is only multiplies and adds
+    for (std::size_t i = 0; i < m_Terms.size(); ++i)
+    {
+        const auto &term = m_Terms[i];
+
+        if (term.Type != FleetKernel::Motion::REVOLUTE)
+            continue;
+
+        const double *q = &m_Positions[term.Variable * m_Stride];
+        double *c = &m_Cos[i * m_Stride];
+        double *s = &m_Sin[i * m_Stride];
+
+        for (std::size_t r = 0; r < m_Stride; ++r)
+        {
+            const double angle = term.Multiplier * q[r] + term.Offset;
+            c[r] = std::cos(angle);
+            s[r] = std::sin(angle);
+        }
+    }
+
+    const FleetKernel::Block block = {m_Terms.data(), m_Terms.size(), m_Stride,
+                                      m_Positions.data(), m_Cos.data(), m_Sin.data(), m_Poses.data()};
+
+    switch (m_Kernel)
+    {
+#if defined(__x86_64__) || defined(_M_X64)
+    case Kernel::AVX512:
+        FleetKernel::SweepAVX512(block);
+        return;
+    case Kernel::AVX2:
+        FleetKernel::SweepAVX2(block);
+        return;
+#endif
+    default:
+        FleetKernel::Sweep<Lanes>(block);
+        return;
+    }
+}
+
+pxr::GfMatrix4d Nexus::Fleet::pose(std::size_t robot, std::size_t link) const noexcept
+{
+    const double *m = &m_Poses[link * ELEMENTS * m_Stride + robot];
+    const auto at = [&](std::size_t e)
+    {
+        return m[e * m_Stride];
+    };
+
+    return pxr::GfMatrix4d(at(0), at(1), at(2), 0.0,
+                           at(3), at(4), at(5), 0.0,
+                           at(6), at(7), at(8), 0.0,
+                           at(9), at(10), at(11), 1.0);
+}
+
+auto Nexus::Fleet::Best() noexcept -> Kernel
+{
+    static const Kernel best = Detect();
+    return best;
+}
+
+const char *Nexus::Fleet::Name(Kernel kernel) noexcept
+{
+    switch (kernel)
+    {
+    case Kernel::AVX512:
+        return "AVX-512";
+    case Kernel::AVX2:
+        return "AVX2";
+    default:
+        return "Scalar";
+    }
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "chain.h"
+#include "fleet_kernel.h"
+
+#include "nexus/logging.h"
+
+#include "pxr/base/gf/matrix4d.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace Nexus
+{
+    ///
+    /// @brief Forward kinematics for many robots sharing one `Chain`.
+    /// Joint positions and link poses are stored as structure-of-arrays,
+    /// one lane per robot, so `solve` evaluates every link of every robot
+    /// in one batched pass with the widest SIMD kernel the CPU supports.
+    ///
+    class Fleet : Logger<"Fleet">
+    {
+    public:
+        /* Instruction sets of the batched kernel, from narrowest to widest */
+        enum class Kernel : char
+        {
+            SCALAR,
+            AVX2,
+            AVX512
+        };
+
+        /* Rows of a pose stored per link, the last column is implied */
+        static constexpr std::size_t ELEMENTS = FleetKernel::ELEMENTS;
+
+    public:
+        ///
+        /// @brief Allocate lanes for a number of robots
+        /// @param chain Joint tree shared by every robot
+        /// @param robots Number of robots
+        /// @param kernel Instruction set to solve with, narrowed to `Best` if wider
+        ///
+        Fleet(const Chain &chain, std::size_t robots, Kernel kernel = Best());
+
+        ///
+        /// @brief Set the joint positions of one robot
+        /// @param robot Index of the robot
+        /// @param positions One position per joint, in `Chain::joints()` order
+        ///
+        void set_positions(std::size_t robot, const double *positions) noexcept;
+
+        ///
+        /// @brief Compute the pose of every link of every robot
+        ///
+        void solve() noexcept;
+
+        ///
+        /// @brief Pose of a link relative to the root link of its robot
+        ///
+        [[nodiscard]]
+        pxr::GfMatrix4d pose(std::size_t robot, std::size_t link) const noexcept;
+
+        [[nodiscard]]
+        std::size_t size() const noexcept { return m_Robots; }
+
+        [[nodiscard]]
+        std::size_t links() const noexcept { return m_Terms.size(); }
+
+        [[nodiscard]]
+        Kernel kernel() const noexcept { return m_Kernel; }
+
+        /* Widest kernel the CPU supports, detected once */
+        [[nodiscard]]
+        static Kernel Best() noexcept;
+
+        [[nodiscard]]
+        static const char *Name(Kernel kernel) noexcept;
+
+    private:
+        std::vector<FleetKernel::Term> m_Terms;
+
+        Kernel m_Kernel = Kernel::SCALAR;
+
+        std::size_t m_Robots = 0;
+
+        /* Robots rounded up to a whole number of lanes of the widest kernel */
+        std::size_t m_Stride = 0;
+
+        /* Indexed by `variable * m_Stride + robot` */
+        std::vector<double> m_Positions;
+
+        /* Indexed by `link * m_Stride + robot` */
+        std::vector<double> m_Cos;
+        std::vector<double> m_Sin;
+
+        /* Indexed by `(link * ELEMENTS + element) * m_Stride + robot` */
+        std::vector<double> m_Poses;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+#include "fleet_kernel.h"
+
+// Compiled with AVX-512F enabled, see CMakeLists.txt
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+
+namespace
+{
+    struct Lanes
+    {
+        static constexpr std::size_t WIDTH = 8;
+
+        __m512d V;
+
+        static Lanes Load(const double *p) noexcept { return {_mm512_loadu_pd(p)}; }
+        static Lanes Set(double x) noexcept { return {_mm512_set1_pd(x)}; }
+        void store(double *p) const noexcept { _mm512_storeu_pd(p, V); }
+
+        /* a * b + c */
+        static Lanes Fma(Lanes a, Lanes b, Lanes c) noexcept { return {_mm512_fmadd_pd(a.V, b.V, c.V)}; }
+    };
+}
+
+void Nexus::FleetKernel::SweepAVX512(const Block &block) noexcept
+{
+    Sweep<Lanes>(block);
+}
+#endif
\ No newline at end of file
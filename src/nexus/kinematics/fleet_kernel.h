@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstddef>
+
+namespace Nexus
+{
+    ///
+    /// @brief The batched sweep of `Fleet::solve`, written once over a pack of
+    /// lanes and compiled per instruction set in its own translation unit, so
+    /// `Fleet` can pick the widest one the CPU supports at runtime.
+    /// Nothing else is included here, so no inline code from other headers is
+    /// ever built with instructions wider than the baseline.
+    ///
+    namespace FleetKernel
+    {
+        /* Same values as `Chain::Motion` */
+        enum class Motion : char
+        {
+            FIXED,
+            REVOLUTE,
+            PRISMATIC
+        };
+
+        /* Rows of a pose stored per link, the last column is implied */
+        inline constexpr std::size_t ELEMENTS = 12;
+
+        /* Constant part of a link transform, shared by every robot */
+        struct Term
+        {
+            Motion Type = Motion::FIXED;
+            int Parent = -1;
+            int Variable = -1;
+            double Multiplier = 1.0;
+            double Offset = 0.0;
+
+            /* Rotation is `cos(q) * A + sin(q) * B + C` */
+            double A[9] = {};
+            double B[9] = {};
+            double C[9] = {};
+
+            /* Translation is `q * D + T` */
+            double D[3] = {};
+            double T[3] = {};
+        };
+
+        /* The arrays of a `Fleet`, see there for their layout */
+        struct Block
+        {
+            const Term *Terms = nullptr;
+            std::size_t Links = 0;
+
+            /* Robots, a whole number of lanes of every kernel */
+            std::size_t Stride = 0;
+
+            const double *Positions = nullptr;
+            const double *Cos = nullptr;
+            const double *Sin = nullptr;
+            double *Poses = nullptr;
+        };
+
+        ///
+        /// @brief Compute every pose of `block` from its cosines and sines
+        /// @tparam Lanes Pack of doubles with `WIDTH`, `Load`, `Set`, `store` and `Fma`
+        ///
+        template <typename Lanes>
+        void Sweep(const Block &block) noexcept
+        {
+            const std::size_t stride = block.Stride;
+
+            // Parents come first, so one sweep per block of robots solves every link
+            for (std::size_t r = 0; r < stride; r += Lanes::WIDTH)
+            {
+                for (std::size_t i = 0; i < block.Links; ++i)
+                {
+                    const auto &term = block.Terms[i];
+
+                    if (term.Parent < 0)
+                        continue;
+
+                    Lanes local[ELEMENTS];
+
+                    switch (term.Type)
+                    {
+                    case Motion::REVOLUTE:
+                    {
+                        const auto c = Lanes::Load(&block.Cos[i * stride + r]);
+                        const auto s = Lanes::Load(&block.Sin[i * stride + r]);
+
+                        for (std::size_t e = 0; e < 9; ++e)
+                            local[e] = Lanes::Fma(c, Lanes::Set(term.A[e]), Lanes::Fma(s, Lanes::Set(term.B[e]), Lanes::Set(term.C[e])));
+                        for (std::size_t e = 0; e < 3; ++e)
+                            local[9 + e] = Lanes::Set(term.T[e]);
+                        break;
+                    }
+                    case Motion::PRISMATIC:
+                    {
+                        const auto q = Lanes::Fma(Lanes::Load(&block.Positions[term.Variable * stride + r]),
+                                                  Lanes::Set(term.Multiplier), Lanes::Set(term.Offset));
+
+                        for (std::size_t e = 0; e < 9; ++e)
+                            local[e] = Lanes::Set(term.C[e]);
+                        for (std::size_t e = 0; e < 3; ++e)
+                            local[9 + e] = Lanes::Fma(q, Lanes::Set(term.D[e]), Lanes::Set(term.T[e]));
+                        break;
+                    }
+                    case Motion::FIXED:
+                    {
+                        for (std::size_t e = 0; e < 9; ++e)
+                            local[e] = Lanes::Set(term.C[e]);
+                        for (std::size_t e = 0; e < 3; ++e)
+                            local[9 + e] = Lanes::Set(term.T[e]);
+                        break;
+                    }
+                    }
+
+                    const double *parent = &block.Poses[term.Parent * ELEMENTS * stride + r];
+                    double *world = &block.Poses[i * ELEMENTS * stride + r];
+                    Lanes p[ELEMENTS];
+
+                    for (std::size_t e = 0; e < ELEMENTS; ++e)
+                        p[e] = Lanes::Load(parent + e * stride);
+
+                    // world = local * parent, with the translation row picking up the parent's
+                    for (std::size_t row = 0; row < 4; ++row)
+                    {
+                        for (std::size_t col = 0; col < 3; ++col)
+                        {
+                            auto sum = row == 3 ? p[9 + col] : Lanes::Set(0.0);
+                            sum = Lanes::Fma(local[row * 3 + 0], p[0 + col], sum);
+                            sum = Lanes::Fma(local[row * 3 + 1], p[3 + col], sum);
+                            sum = Lanes::Fma(local[row * 3 + 2], p[6 + col], sum);
+                            sum.store(world + (row * 3 + col) * stride);
+                        }
+                    }
+                }
+            }
+        }
+
+#if defined(__x86_64__) || defined(_M_X64)
+        /* Built with AVX2 and FMA enabled, only call if the CPU has both */
+        void SweepAVX2(const Block &block) noexcept;
+
+        /* Built with AVX-512F enabled, only call if the CPU has it */
+        void SweepAVX512(const Block &block) noexcept;
+#endif
+    }
+}
\ No newline at end of file
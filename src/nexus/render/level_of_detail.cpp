@@ -0,0 +1,150 @@
+#include "level_of_detail.h"
+
+#include "nexus/convert/mesh_import.h"
+#include "nexus/core/world.h"
+
+#include "pxr/base/gf/frustum.h"
+#include "pxr/usd/sdf/changeBlock.h"
+#include "pxr/usd/sdf/primSpec.h"
+#include "pxr/usd/usd/prim.h"
+#include "pxr/usd/usd/primRange.h"
+#include "pxr/usd/usd/variantSets.h"
+#include "pxr/usd/usdGeom/bboxCache.h"
+#include "pxr/usd/usdGeom/camera.h"
+#include "pxr/usd/usdGeom/tokens.h"
+#include "pxr/usd/usdGeom/xformCache.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+void Nexus::LevelOfDetail::update(std::span<const Render> renders)
+{
+    std::vector<std::pair<pxr::SdfPath, std::size_t>> changes;
+    {
+        auto [stage, lock] = World::GetStageReadAccess();
+
+        if (m_Stage != pxr::UsdStagePtr(stage) || m_Revision != World::GetStructureRevision())
+            _discover(stage);
+
+        // Largest radius in pixels of each target over all viewports
+        std::vector<double> pixels(m_Targets.size(), 0.0);
+
+        for (const auto &render : renders)
+        {
+            pxr::GfFrustum frustum = render.Camera.GetFrustum();
+
+            if (!render.FreeCamera)
+            {
+                const pxr::UsdGeomCamera camera(stage->GetPrimAtPath(render.CameraPath));
+
+                if (!camera)
+                    continue;
+
+                frustum = camera.GetCamera(render.Params.frame).GetFrustum();
+            }
+
+            const auto eye = frustum.GetPosition();
+            const bool perspective = frustum.GetProjectionType() == pxr::GfFrustum::Perspective;
+
+            // Pixels per unit at distance one, the window sits on that plane
+            const double scale = render.Size[1] / frustum.GetWindow().GetSize()[1] * render.Params.complexity;
+
+            pxr::UsdGeomXformCache transforms(render.Params.frame);
+
+            for (std::size_t i = 0; i < m_Targets.size(); ++i)
+            {
+                const auto &target = m_Targets[i];
+                const auto prim = stage->GetPrimAtPath(target.Path);
+
+                if (!prim)
+                    continue;
+
+                const auto world = transforms.GetLocalToWorldTransform(prim);
+                const auto center = world.Transform(target.Bound.GetMidpoint());
+                const double radius = target.Bound.GetSize().GetLength() / 2.0;
+                const double distance = (center - eye).GetLength();
+
+                if (distance <= radius)
+                {
+                    pixels[i] = std::numeric_limits<double>::infinity();
+                    continue;
+                }
+                pixels[i] = std::max(pixels[i], perspective ? radius / distance * scale : radius * scale);
+            }
+        }
+
+        for (std::size_t i = 0; i < m_Targets.size(); ++i)
+        {
+            auto &target = m_Targets[i];
+            std::size_t level = 0;
+
+            // Stepping past the boundary below the current level needs some margin
+            while (ENABLED && level + 1 < target.Levels && level < THRESHOLDS.size() &&
+                   pixels[i] < THRESHOLDS[level] * (level >= target.Level ? 1.0 - HYSTERESIS : 1.0))
+                level++;
+
+            if (level != target.Level)
+            {
+                target.Level = level;
+                changes.emplace_back(target.Path, level);
+            }
+        }
+    }
+
+    if (changes.empty())
+        return;
+
+    auto [stage, lock] = World::GetStageWriteAccess();
+    const auto session = stage->GetSessionLayer();
+    pxr::SdfChangeBlock block;
+
+    for (const auto &[path, level] : changes)
+    {
+        auto spec = pxr::SdfCreatePrimInLayer(session, path);
+
+        if (spec)
+            spec->SetVariantSelection(MeshImport::LEVEL_SET, MeshImport::LevelName(level));
+    }
+}
+
+void Nexus::LevelOfDetail::_discover(const pxr::UsdStageRefPtr &stage)
+{
+    if (m_Stage != pxr::UsdStagePtr(stage))
+        m_Targets.clear();
+
+    m_Stage = stage;
+    m_Revision = World::GetStructureRevision();
+
+    std::vector<Target> targets;
+    pxr::UsdGeomBBoxCache bounds(pxr::UsdTimeCode::Default(),
+                                 {pxr::UsdGeomTokens->default_, pxr::UsdGeomTokens->render, pxr::UsdGeomTokens->proxy});
+
+    for (const pxr::UsdPrim &prim : stage->Traverse())
+    {
+        if (!prim.HasVariantSets())
+            continue;
+
+        const auto set = prim.GetVariantSets().GetVariantSet(MeshImport::LEVEL_SET);
+        const auto levels = set.GetVariantNames().size();
+
+        if (levels == 0)
+            continue;
+
+        auto &target = targets.emplace_back();
+        target.Path = prim.GetPath();
+        target.Bound = bounds.ComputeUntransformedBound(prim).ComputeAlignedRange();
+        target.Levels = levels;
+
+        // Keep what was selected before
+        const auto found = std::ranges::find(m_Targets, target.Path, &Target::Path);
+
+        if (found != m_Targets.end())
+            target.Level = found->Level;
+    }
+
+    if (targets.size() != m_Targets.size())
+        LOG_BASIC("Tracking {} meshes with levels of detail", targets.size());
+
+    m_Targets = std::move(targets);
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "nexus/logging.h"
+#include "nexus/render/render.h"
+
+#include "pxr/base/gf/range3d.h"
+#include "pxr/usd/sdf/path.h"
+#include "pxr/usd/usd/stage.h"
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace Nexus
+{
+    ///
+    /// @brief Picks the level of detail of each imported mesh from its largest
+    /// size on screen across the viewports. Selections are authored in the
+    /// session layer and never saved. Meshes are found by traversing the stage
+    /// only when it is replaced or its structure changes.
+    ///
+    /// Known limitation: variant selections are per stage, not per view, so
+    /// every viewport draws the level the closest one needs and a distant
+    /// viewport still renders the finest level.
+    ///
+    class LevelOfDetail : Logger<"Level of Detail">
+    {
+        struct Target
+        {
+            pxr::SdfPath Path;
+
+            /* Bounds in the space of the prim, excluding its own transform */
+            pxr::GfRange3d Bound;
+
+            std::size_t Levels = 1;
+            std::size_t Level = 0;
+        };
+
+    public:
+        ///
+        /// @brief Select a level for every mesh with a level of detail variant set
+        /// @param renders Active viewports, main thread only
+        ///
+        void update(std::span<const Render> renders);
+
+    public:
+        static inline bool ENABLED = true;
+
+        /* Radius in pixels below which each level gives way to the next */
+        static inline std::array<double, 2> THRESHOLDS = {64.0, 16.0};
+
+        /* Fraction below a threshold before switching to a coarser level */
+        static inline double HYSTERESIS = 0.2;
+
+    private:
+        void _discover(const pxr::UsdStageRefPtr &stage);
+
+    private:
+        std::vector<Target> m_Targets;
+
+        /* Targets belong to this stage, as of this `World::GetStructureRevision` */
+        pxr::UsdStagePtr m_Stage;
+        std::size_t m_Revision = 0;
+    };
+}
\ No newline at end of file
@@ -21,7 +21,7 @@ namespace Nexus
             Params.gammaCorrectColors = false;
             Params.showGuides = false;
             Params.showProxy = false;
-            Params.showRender = false;
+            Params.showRender = true;
             PARAMS = Params;
         }
 
@@ -1,11 +1,14 @@
 #pragma once
 
+#include <atomic>
 #include <concepts>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <shared_mutex>
 #include <string_view>
 #include <type_traits>
+#include <vector>
 
 namespace Nexus
 {
@@ -232,4 +235,169 @@ namespace Nexus
 
         std::size_t m_Index = 0;
     };
+
+    ///
+    /// @brief A lock-free triple buffer for one producer and one consumer.
+    /// The producer fills `back()` and calls `publish()`; the consumer
+    /// calls `fetch()` and reads `front()` which is never written to.
+    /// @tparam T Element type
+    ///
+    template <typename T>
+    class TripleBuffer
+    {
+    public:
+        [[nodiscard]]
+        T &back() noexcept { return m_Buffer[m_Back]; }
+
+        [[nodiscard]]
+        const T &front() const noexcept { return m_Buffer[m_Front]; }
+
+        ///
+        /// @brief Swap the back buffer with the middle buffer
+        ///
+        void publish() noexcept
+        {
+            m_Back = m_Middle.exchange(static_cast<std::uint8_t>(m_Back | DIRTY), std::memory_order_acq_rel) & INDEX;
+        }
+
+        ///
+        /// @brief Swap the front buffer with the middle buffer if it is newer
+        /// @return Whether `front()` has changed
+        ///
+        [[nodiscard]]
+        bool fetch() noexcept
+        {
+            if (!(m_Middle.load(std::memory_order_relaxed) & DIRTY))
+                return false;
+
+            m_Front = m_Middle.exchange(m_Front, std::memory_order_acq_rel) & INDEX;
+            return true;
+        }
+
+    private:
+        static constexpr std::uint8_t INDEX = 0b011;
+        static constexpr std::uint8_t DIRTY = 0b100;
+
+        T m_Buffer[3];
+
+        std::uint8_t m_Back = 0;
+        std::uint8_t m_Front = 2;
+
+        std::atomic<std::uint8_t> m_Middle = 1;
+    };
+
+    ///
+    /// @brief Densely packed elements addressed by stable handles.
+    /// Erasing moves the last element into the hole, so iteration is over
+    /// a contiguous array, while handles go through a slot that tracks the
+    /// element and a generation that rejects handles to erased elements.
+    /// @tparam T Element type
+    ///
+    template <typename T>
+    class SlotMap
+    {
+    public:
+        struct Handle
+        {
+            std::uint32_t Index = static_cast<std::uint32_t>(-1);
+            std::uint32_t Generation = 0;
+
+            bool operator==(const Handle &) const noexcept = default;
+        };
+
+        template <typename... Args>
+        Handle emplace(Args &&...args)
+        {
+            std::uint32_t index;
+
+            if (m_Free.empty())
+            {
+                index = static_cast<std::uint32_t>(m_Slots.size());
+                m_Slots.emplace_back();
+            }
+            else
+            {
+                index = m_Free.back();
+                m_Free.pop_back();
+            }
+
+            m_Slots[index].Dense = static_cast<std::uint32_t>(m_Values.size());
+            m_Values.emplace_back(std::forward<Args>(args)...);
+            m_Owners.push_back(index);
+
+            return {index, m_Slots[index].Generation};
+        }
+
+        bool erase(Handle handle)
+        {
+            if (!contains(handle))
+                return false;
+
+            auto &slot = m_Slots[handle.Index];
+
+            if (slot.Dense != m_Values.size() - 1)
+            {
+                m_Values[slot.Dense] = std::move(m_Values.back());
+                m_Owners[slot.Dense] = m_Owners.back();
+                m_Slots[m_Owners.back()].Dense = slot.Dense;
+            }
+            m_Values.pop_back();
+            m_Owners.pop_back();
+
+            slot.Generation++;
+            m_Free.push_back(handle.Index);
+            return true;
+        }
+
+        [[nodiscard]]
+        bool contains(Handle handle) const noexcept
+        {
+            return handle.Index < m_Slots.size() && m_Slots[handle.Index].Generation == handle.Generation;
+        }
+
+        /* Null if the handle has been erased */
+        [[nodiscard]]
+        T *get(Handle handle) noexcept
+        {
+            return contains(handle) ? &m_Values[m_Slots[handle.Index].Dense] : nullptr;
+        }
+
+        [[nodiscard]]
+        const T *get(Handle handle) const noexcept
+        {
+            return contains(handle) ? &m_Values[m_Slots[handle.Index].Dense] : nullptr;
+        }
+
+        [[nodiscard]]
+        auto begin() noexcept { return m_Values.begin(); }
+
+        [[nodiscard]]
+        auto end() noexcept { return m_Values.end(); }
+
+        [[nodiscard]]
+        auto begin() const noexcept { return m_Values.begin(); }
+
+        [[nodiscard]]
+        auto end() const noexcept { return m_Values.end(); }
+
+        [[nodiscard]]
+        auto size() const noexcept { return m_Values.size(); }
+
+        [[nodiscard]]
+        bool empty() const noexcept { return m_Values.empty(); }
+
+    private:
+        struct Slot
+        {
+            std::uint32_t Dense = 0;
+            std::uint32_t Generation = 0;
+        };
+
+        /* Packed elements and the slot that owns each */
+        std::vector<T> m_Values;
+        std::vector<std::uint32_t> m_Owners;
+
+        std::vector<Slot> m_Slots;
+        std::vector<std::uint32_t> m_Free;
+    };
 }
\ No newline at end of file
@@ -0,0 +1,307 @@
+#include "fleet_benchmark.h"
+
+#include "nexus/core/world.h"
+#include "nexus/entity/robot.h"
+
+#include "pxr/usd/sdf/changeBlock.h"
+#include "pxr/usd/sdf/path.h"
+
+#include "imgui.h"
+
+#include "rclcpp/executors/single_threaded_executor.hpp"
+#include "rclcpp/node.hpp"
+#include "tf2_msgs/msg/tf_message.hpp"
+
+#include "urdf/model.h"
+
+#include <chrono>
+#include <cmath>
+#include <format>
+#include <iterator>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <fstream>
+#include <unistd.h>
+#endif
+
+static std::size_t ResidentBytes()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return counters.WorkingSetSize;
+#else
+    std::size_t pages = 0, resident = 0;
+
+    if (std::ifstream("/proc/self/statm") >> pages >> resident)
+        return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+    return 0;
+}
+
+///
+/// @brief Publishes a moving TF tree for each of "robot_0" to "robot_<N-1>"
+/// on "/robot_<i>/tf", with frames prefixed "robot_<i>/" like a namespaced
+/// robot_state_publisher would.
+///
+class Nexus::SyntheticTF : public rclcpp::Node
+{
+    using TF_Message = tf2_msgs::msg::TFMessage;
+
+public:
+    SyntheticTF(const Chain &chain, std::size_t robots)
+        : rclcpp::Node("synthetic_tf"), m_Chain(chain), m_Positions(chain.joints().size())
+    {
+        for (std::size_t i = 0; i < robots; ++i)
+            m_Publishers.push_back(this->create_publisher<TF_Message>(std::format("/robot_{}/tf", i), rclcpp::QoS(100)));
+
+        m_Timer = this->create_wall_timer(std::chrono::milliseconds(10), [this]()
+                                          { _tick(); });
+    }
+
+private:
+    void _tick()
+    {
+        const auto &links = m_Chain.links();
+        const auto now = this->now();
+        const double t = now.seconds();
+
+        for (std::size_t r = 0; r < m_Publishers.size(); ++r)
+        {
+            const std::string prefix = std::format("robot_{}/", r);
+
+            for (std::size_t j = 0; j < m_Positions.size(); ++j)
+                m_Positions[j] = 0.5 * std::sin(t + 0.1 * r + j);
+
+            TF_Message message;
+            message.transforms.reserve(links.size());
+
+            for (std::size_t i = 0; i < links.size(); ++i)
+            {
+                if (links[i].Parent < 0)
+                    continue;
+
+                const auto local = m_Chain.local(i, m_Positions.data());
+                const auto q = local.ExtractRotationQuat();
+                const auto p = local.ExtractTranslation();
+
+                auto &stamped = message.transforms.emplace_back();
+                stamped.header.stamp = now;
+                stamped.header.frame_id = prefix + links[links[i].Parent].Name;
+                stamped.child_frame_id = prefix + links[i].Name;
+                stamped.transform.translation.x = p[0];
+                stamped.transform.translation.y = p[1];
+                stamped.transform.translation.z = p[2];
+                stamped.transform.rotation.w = q.GetReal();
+                stamped.transform.rotation.x = q.GetImaginary()[0];
+                stamped.transform.rotation.y = q.GetImaginary()[1];
+                stamped.transform.rotation.z = q.GetImaginary()[2];
+            }
+            m_Publishers[r]->publish(message);
+        }
+    }
+
+private:
+    const Chain m_Chain;
+
+    std::vector<double> m_Positions;
+
+    std::vector<rclcpp::Publisher<TF_Message>::SharedPtr> m_Publishers;
+
+    rclcpp::TimerBase::SharedPtr m_Timer;
+};
+
+Nexus::FleetBenchmark::~FleetBenchmark()
+{
+    _stop();
+    _remove_robots();
+}
+
+void Nexus::FleetBenchmark::draw()
+{
+    if (ImGui::Begin("Fleet Benchmark"))
+    {
+        const bool running = m_Phase != Phase::IDLE;
+
+        ImGui::BeginDisabled(running);
+        ImGui::InputTextWithHint("URDF", "assets/franka/franka.urdf", m_URDF, sizeof(m_URDF));
+        ImGui::BeginDisabled(m_URDF[0] == '\0');
+
+        if (ImGui::Button("Run"))
+            _start();
+
+        ImGui::EndDisabled();
+        ImGui::EndDisabled();
+
+        if (running)
+        {
+            ImGui::SameLine();
+
+            if (ImGui::Button("Stop"))
+            {
+                _stop();
+                _remove_robots();
+                m_Phase = Phase::IDLE;
+            }
+            ImGui::SameLine();
+            ImGui::Text("%zu/%zu robots", m_Spawned, COUNTS[m_Step]);
+        }
+
+        if (ImGui::BeginTable("Results", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+        {
+            ImGui::TableSetupColumn("Robots");
+            ImGui::TableSetupColumn("Frame (ms)");
+            ImGui::TableSetupColumn("Latency (ms)");
+            ImGui::TableSetupColumn("Memory (MB)");
+            ImGui::TableHeadersRow();
+
+            for (const auto &result : m_Results)
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::Text("%zu", result.Robots);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", result.FrameTime);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", result.Latency);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", result.Memory / 1048576.0);
+            }
+            ImGui::EndTable();
+        }
+    }
+    ImGui::End();
+
+    if (m_Phase != Phase::IDLE)
+        _step(ImGui::GetIO().DeltaTime);
+}
+
+void Nexus::FleetBenchmark::_start()
+{
+    urdf::Model model;
+
+    if (!model.initFile(m_URDF))
+    {
+        LOG_ERROR("Error parsing URDF at {}", m_URDF);
+        return;
+    }
+    m_Chain = Chain(model);
+    _remove_robots();
+    m_Results.clear();
+    m_Step = 0;
+    m_Phase = Phase::SPAWN;
+
+    LOG_EVENT("Running fleet benchmark with {}", model.name_);
+}
+
+void Nexus::FleetBenchmark::_step(double dt)
+{
+    switch (m_Phase)
+    {
+    case Phase::SPAWN:
+    {
+        // One robot per frame so the window stays responsive
+        if (m_Spawned < COUNTS[m_Step])
+        {
+            m_Robots.push_back(World::AddEntity<Robot>(m_URDF, std::format("robot_{}", m_Spawned++)));
+            break;
+        }
+        _publish(COUNTS[m_Step]);
+        m_Elapsed = 0.0;
+        m_Phase = Phase::WARMUP;
+        break;
+    }
+    case Phase::WARMUP:
+    {
+        if ((m_Elapsed += dt) < WARMUP)
+            break;
+
+        m_Elapsed = 0.0;
+        m_FrameTime = 0.0;
+        m_Latency = 0.0;
+        m_Frames = 0;
+        m_Phase = Phase::MEASURE;
+        break;
+    }
+    case Phase::MEASURE:
+    {
+        m_FrameTime += dt * 1000.0;
+        m_Latency += Robot::LATENCY;
+        m_Frames++;
+
+        if ((m_Elapsed += dt) < MEASURE)
+            break;
+
+        const auto &result = m_Results.emplace_back(COUNTS[m_Step],
+                                                    m_FrameTime / m_Frames,
+                                                    m_Latency / m_Frames,
+                                                    ResidentBytes());
+
+        LOG_EVENT("{} robots: {:.2f} ms frame, {:.2f} ms latency, {} MB",
+                  result.Robots, result.FrameTime, result.Latency, result.Memory >> 20);
+
+        if (++m_Step < std::size(COUNTS))
+        {
+            m_Phase = Phase::SPAWN;
+            break;
+        }
+        _stop();
+        _remove_robots();
+        m_Phase = Phase::IDLE;
+        break;
+    }
+    case Phase::IDLE:
+        break;
+    }
+}
+
+void Nexus::FleetBenchmark::_publish(std::size_t robots)
+{
+    _stop();
+
+    auto publisher = std::make_shared<SyntheticTF>(m_Chain, robots);
+    m_Publisher = publisher;
+
+    m_Spinner = std::jthread(
+        [publisher](std::stop_token stop)
+        {
+            rclcpp::executors::SingleThreadedExecutor executor;
+            executor.add_node(publisher);
+
+            while (!stop.stop_requested() && rclcpp::ok())
+                executor.spin_once(std::chrono::milliseconds(50));
+        });
+}
+
+void Nexus::FleetBenchmark::_stop()
+{
+    if (m_Spinner.joinable())
+    {
+        m_Spinner.request_stop();
+        m_Spinner.join();
+    }
+    m_Publisher.reset();
+}
+
+void Nexus::FleetBenchmark::_remove_robots()
+{
+    for (const auto handle : m_Robots)
+        World::RemoveEntity(handle);
+
+    if (m_Spawned > 0)
+    {
+        // Each robot authored itself under its namespace
+        auto [stage, lock] = World::GetStageWriteAccess();
+        pxr::SdfChangeBlock block;
+
+        for (std::size_t i = 0; i < m_Spawned; ++i)
+            stage->RemovePrim(pxr::SdfPath(std::format("/robot_{}", i)));
+    }
+    m_Robots.clear();
+    m_Spawned = 0;
+}
\ No newline at end of file
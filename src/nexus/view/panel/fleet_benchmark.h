@@ -0,0 +1,81 @@
+#pragma once
+
+#include "nexus/core/world.h"
+#include "nexus/kinematics/chain.h"
+#include "nexus/logging.h"
+
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace Nexus
+{
+    class SyntheticTF;
+
+    class FleetBenchmark : Logger<"Fleet Benchmark">
+    {
+        enum class Phase : char
+        {
+            IDLE,
+            SPAWN,
+            WARMUP,
+            MEASURE
+        };
+
+        struct Result
+        {
+            std::size_t Robots = 0;
+
+            /* Averages in milliseconds */
+            double FrameTime = 0.0;
+            double Latency = 0.0;
+
+            /* Resident set size in bytes */
+            std::size_t Memory = 0;
+        };
+
+    public:
+        ~FleetBenchmark();
+
+        void draw();
+
+    private:
+        void _start();
+        void _step(double dt);
+        void _publish(std::size_t robots);
+        void _stop();
+        void _remove_robots();
+
+    private:
+        /* Robots spawned for each measurement */
+        static constexpr std::size_t COUNTS[] = {1, 10, 50, 100};
+
+        /* Seconds before and during each measurement */
+        static constexpr double WARMUP = 2.0;
+        static constexpr double MEASURE = 5.0;
+
+        /* Filled in by the user, e.g. "assets/franka/franka.urdf" */
+        char m_URDF[256] = {};
+
+        Phase m_Phase = Phase::IDLE;
+        std::size_t m_Step = 0;
+        double m_Elapsed = 0.0;
+
+        /* Sums over the frames of the current measurement */
+        double m_FrameTime = 0.0;
+        double m_Latency = 0.0;
+        std::size_t m_Frames = 0;
+
+        /* Robots of the current run, named "robot_<index>" and removed when it ends */
+        std::size_t m_Spawned = 0;
+        std::vector<World::EntityHandle> m_Robots;
+
+        std::vector<Result> m_Results;
+
+        Chain m_Chain;
+
+        std::shared_ptr<SyntheticTF> m_Publisher;
+        std::jthread m_Spinner;
+    };
+}
\ No newline at end of file
@@ -31,11 +31,11 @@ namespace Nexus
                         },
                         FileDialog::USD_FILTER);
                 }
-                if (ImGui::MenuItem("Save", "Ctrl+S"))
+                if (ImGui::MenuItem("Save", "Ctrl+S", false, !World::IsSaving()))
                 {
                     World::SaveStage();
                 }
-                if (ImGui::MenuItem("Export", "Ctrl+E"))
+                if (ImGui::MenuItem("Export", "Ctrl+E", false, !World::IsSaving()))
                 {
                     FileDialog::Show<FileDialog::Mode::SAVE>(
                         [](std::string path, int)
@@ -46,6 +46,28 @@ namespace Nexus
                 }
                 ImGui::EndMenu();
             }
+            if (ImGui::BeginMenu("Record"))
+            {
+                if (!World::IsRecording() && ImGui::MenuItem("Start"))
+                {
+                    FileDialog::Show<FileDialog::Mode::SAVE>(
+                        [](std::string path, int)
+                        {
+                            World::StartRecording(path);
+                        },
+                        FileDialog::USD_FILTER);
+                }
+                if (World::IsRecording() && ImGui::MenuItem("Stop"))
+                {
+                    World::StopRecording();
+                }
+                ImGui::EndMenu();
+            }
+            if (World::IsSaving())
+            {
+                const float indeterminate = -1.f * static_cast<float>(ImGui::GetTime());
+                ImGui::ProgressBar(indeterminate, ImVec2(120.f, 0.f), "Saving...");
+            }
             ImGui::EndMainMenuBar();
         }
     }
@@ -19,6 +19,7 @@
 #include "imgui.h"
 
 #include <format>
+#include <span>
 
 const char *DRAW_MODES[] = {
     "Points",
@@ -71,6 +72,8 @@ void Nexus::MultiViewport::stop_engine()
 
 void Nexus::MultiViewport::draw()
 {
+    m_LevelOfDetail.update(std::span(m_Renders.data(), m_Active));
+
     for (std::size_t i = 0; i < m_Active; ++i)
         _draw_render(i);
 
@@ -335,6 +338,9 @@ void Nexus::MultiViewport::_draw_static_render_parameter()
         ImGui::SliderFloat("Complexity", &Render::PARAMS.complexity, 1.f, 1.5f, "%.1f");
         ImGui::Combo("Draw Mode", (int *)&Render::PARAMS.drawMode, DRAW_MODES, std::size(DRAW_MODES));
         ImGui::Combo("Cull Style", (int *)&Render::PARAMS.cullStyle, CULL_STYLES, std::size(CULL_STYLES));
+        ImGui::Checkbox("Level of Detail", &LevelOfDetail::ENABLED);
+        ImGui::InputDouble("LOD Threshold (px)", &LevelOfDetail::THRESHOLDS[0], 0.0, 0.0, "%.0f");
+        ImGui::InputDouble("Low LOD Threshold (px)", &LevelOfDetail::THRESHOLDS[1], 0.0, 0.0, "%.0f");
         ImGui::Checkbox("Live Playback", &Render::LIVE);
     }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "nexus/logging.h"
+#include "nexus/render/level_of_detail.h"
 #include "nexus/render/render.h"
 
 #include "pxr/usd/sdf/path.h"
@@ -54,5 +55,8 @@ namespace Nexus
 
         // Path of each camera in the scene
         std::vector<pxr::SdfPath> m_CameraPaths;
+
+        // Level of detail selection for the active renders
+        LevelOfDetail m_LevelOfDetail;
     };
 }
\ No newline at end of file
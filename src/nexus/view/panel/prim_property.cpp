@@ -34,7 +34,7 @@ void Nexus::PrimProperty::draw()
     {
         if (m_ContextPrim.IsValid())
         {
-            auto [stage, lock] = World::GetStageWriteAccess();
+            auto [stage, lock] = World::GetStageReadAccess();
 
             for (const auto &attribute : m_ContextPrim.GetAttributes())
             {
@@ -18,11 +18,11 @@ Nexus::SceneHierarchy::SceneHierarchy()
         [this](const SceneResetEvent &)
         {
             m_ContextHash = 0;
-            auto [stage, _] = World::GetStageWriteAccess();
+            auto [stage, _] = World::GetStageReadAccess();
             m_Range = pxr::UsdPrimRange::PreAndPostVisit(stage->GetPseudoRoot());
         });
 
-    auto [stage, _] = World::GetStageWriteAccess();
+    auto [stage, _] = World::GetStageReadAccess();
     m_Range = pxr::UsdPrimRange::PreAndPostVisit(stage->GetPseudoRoot());
 }
 
@@ -13,6 +13,8 @@
 #include "imgui_impl_sdl3.h"
 #include "imgui_impl_opengl3.h"
 
+#include <algorithm>
+
 #define SDL_TRY(function)                                            \
     do                                                               \
     {                                                                \
@@ -139,6 +141,7 @@ void Nexus::Window::render_frame()
     draw_menu_bar();
     draw_log_history();
 
+    m_FleetBenchmark.draw();
     m_PrimProperty.draw();
     m_MultiViewport.draw();
     m_SceneHierarchy.draw();
@@ -268,7 +271,7 @@ void Nexus::Window::_draw_low_level()
     {
         if (ImGui::Button("Test Add Entity"))
         {
-            World::AddEntity<Robot>(this, R"(C:\pixi_ws\Nexus\assets\franka\franka.urdf)");
+            World::AddEntity<Robot>(R"(C:\pixi_ws\Nexus\assets\franka\franka.urdf)");
         }
 
         ImGui::EndMainMenuBar();
@@ -293,6 +296,60 @@ void Nexus::Window::_draw_low_level()
 
         ImGui::Text("FPS: %.1f (%.1f ms)", fps, dt);
 
+        const auto stats = World::GetStageStats();
+        ImGui::Text("Stage: %zu commands (%.2f ms)", stats.Commands, stats.Milliseconds);
+        ImGui::Text("Entities: %zu", World::GetEntities().size());
+        ImGui::Text("Poses: %zu written, %zu skipped", Robot::WRITTEN, Robot::SKIPPED);
+        ImGui::Text("Pose Latency: %.2f ms", Robot::LATENCY);
+
+        ImGui::SeparatorText("Scheduler");
+
+        auto &scheduler = World::GetScheduler();
+        const auto ticks = scheduler.stats();
+        double rate = scheduler.Rate;
+
+        if (ImGui::InputDouble("Rate (Hz)", &rate, 10.0, 100.0, "%.0f"))
+            scheduler.Rate = std::clamp(rate, 1.0, 1000.0);
+
+        ImGui::Text("Tick: %.2f ms period, %.2f ms busy", ticks.Period, ticks.Busy);
+        ImGui::Text("Jitter: %.3f ms (worst %.3f ms)", ticks.Jitter, ticks.Worst);
+
+        if (ImGui::TreeNode("Entity Cost"))
+        {
+            for (const auto &entity : World::GetEntities())
+                ImGui::Text("%s: %.3f ms", entity->get_fully_qualified_name(), entity->get_cost());
+
+            ImGui::TreePop();
+        }
+
+        ImGui::SeparatorText("Deadband");
+
+        ImGui::Checkbox("Skip Unchanged Poses", &Robot::DEADBAND.Enabled);
+        ImGui::InputDouble("Position (m)##Deadband", &Robot::DEADBAND.Position, 0.0001, 0.001, "%.4f");
+        ImGui::InputDouble("Angle (deg)##Deadband", &Robot::DEADBAND.Angle, 0.01, 0.1, "%.2f");
+
+        ImGui::SeparatorText("Mesh Import");
+
+        // Applies to robots spawned afterwards
+        ImGui::Checkbox("Compact Meshes", &UrdfImport::OPTIONS.Compact);
+
+        ImGui::SeparatorText("Retention");
+
+        auto &retention = World::GetRetentionPolicy();
+        ImGui::TextDisabled("0 keeps every sample");
+        ImGui::InputDouble("Seconds", &retention.Seconds, 10.0, 60.0, "%.0f");
+        ImGui::InputInt("Samples", &retention.Samples, 100, 1000);
+
+        retention.Seconds = std::max(retention.Seconds, 0.0);
+        retention.Samples = std::max(retention.Samples, 0);
+
+        ImGui::SeparatorText("Keyframe Reduction");
+
+        auto &tolerance = World::GetReductionTolerance();
+        ImGui::Checkbox("Reduce Keyframes", &tolerance.Enabled);
+        ImGui::InputDouble("Position (m)", &tolerance.Position, 0.0001, 0.001, "%.4f");
+        ImGui::InputDouble("Angle (deg)", &tolerance.Angle, 0.01, 0.1, "%.2f");
+
         ImGui::SeparatorText("Swap Interval");
 
         if (ImGui::Button("Max"))
@@ -2,6 +2,7 @@
 
 #include "filedialog.h"
 
+#include "panel/fleet_benchmark.h"
 #include "panel/multi_viewport.h"
 #include "panel/prim_property.h"
 #include "panel/scene_hierarchy.h"
@@ -50,6 +51,7 @@ namespace Nexus
         bool m_ShowDemo = false;
 
         /* View Panels */
+        FleetBenchmark m_FleetBenchmark;
         PrimProperty m_PrimProperty;
         MultiViewport m_MultiViewport;
         SceneHierarchy m_SceneHierarchy;
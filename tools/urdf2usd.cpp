@@ -0,0 +1,147 @@
+//
+//  Converts URDF files to .usdc without a window, a World or a ROS node,
+//  with the same code `Robot` uses. Robots are converted in parallel and
+//  their meshes are cached in `<output>/meshes`, referenced by relative
+//  paths so the output folder can be moved as a whole. `--compact` leaves
+//  out normals that match the smooth normals the renderer computes.
+//
+//  Usage: urdf2usd <urdf or directory>... [-o output] [-j jobs] [--compact]
+//
+#include "nexus/convert/mesh_cache.h"
+#include "nexus/convert/urdf_import.h"
+#include "nexus/core/thread_pool.h"
+
+#include "pxr/base/tf/stringUtils.h"
+#include "pxr/usd/sdf/layer.h"
+#include "pxr/usd/usdGeom/tokens.h"
+
+#include "urdf/model.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+GENERATE_LOG_FUNCTIONS(Converter)
+
+namespace fs = std::filesystem;
+
+static bool IsURDF(const fs::path &path)
+{
+    const auto name = path.filename().string();
+    return name.ends_with(".urdf") || name.ends_with(".urdf.xml");
+}
+
+// "robot.urdf.xml" and "robot.urdf" both become "robot"
+static std::string Stem(const fs::path &path)
+{
+    auto name = path.filename().string();
+    return name.substr(0, name.find(".urdf"));
+}
+
+int main(int argc, char **argv)
+{
+    std::vector<fs::path> inputs;
+    fs::path output = ".";
+    std::size_t jobs = std::max(std::thread::hardware_concurrency(), 1u);
+    Nexus::MeshImport::Options options;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string argument = argv[i];
+
+        if (argument == "-o" && i + 1 < argc)
+        {
+            output = argv[++i];
+        }
+        else if (argument == "-j" && i + 1 < argc)
+        {
+            jobs = std::max<std::size_t>(std::stoul(argv[++i]), 1);
+        }
+        else if (argument == "--compact")
+        {
+            options.Compact = true;
+        }
+        else if (fs::is_directory(argument))
+        {
+            for (const auto &entry : fs::recursive_directory_iterator(argument))
+            {
+                if (entry.is_regular_file() && IsURDF(entry.path()))
+                    inputs.push_back(entry.path());
+            }
+        }
+        else
+        {
+            inputs.emplace_back(argument);
+        }
+    }
+
+    if (inputs.empty())
+    {
+        std::cerr << "Usage: " << argv[0] << " <urdf or directory>... [-o output] [-j jobs] [--compact]\n";
+        return EXIT_FAILURE;
+    }
+
+    fs::create_directories(output);
+    Nexus::MeshCache::SetDirectory(output / "meshes");
+
+    std::atomic<std::size_t> converted = 0;
+    std::atomic<std::size_t> links = 0;
+    std::atomic<std::uintmax_t> bytes = 0;
+
+    const auto convert = [&](std::size_t i)
+    {
+        const auto &input = inputs[i];
+        urdf::Model model;
+
+        if (!model.initFile(input.string()))
+        {
+            LOG_ERROR_Converter("Error parsing URDF at {}", input.string());
+            return;
+        }
+
+        const pxr::SdfPath root('/' + pxr::TfMakeValidIdentifier(model.name_));
+        const auto layer = Nexus::UrdfImport::Build(model, root, options);
+        const auto path = output / (Stem(input) + ".usdc");
+
+        // Same conventions as the stages the app creates
+        layer->SetDefaultPrim(root.GetNameToken());
+        layer->SetField(pxr::SdfPath::AbsoluteRootPath(), pxr::UsdGeomTokens->upAxis, pxr::VtValue(pxr::UsdGeomTokens->z));
+        layer->SetField(pxr::SdfPath::AbsoluteRootPath(), pxr::UsdGeomTokens->metersPerUnit, pxr::VtValue(1.0));
+
+        // Meshes are already cached in `<output>/meshes`, so this only makes them relative
+        Nexus::MeshCache::Localize(layer, output);
+
+        if (!layer->Export(path.string()))
+        {
+            LOG_ERROR_Converter("Could not write {}", path.string());
+            return;
+        }
+
+        converted++;
+        links += model.links_.size();
+        bytes += fs::file_size(path);
+        LOG_EVENT_Converter("Wrote {}", path.string());
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+
+    // Meshes of every robot share `MeshImport::Pool()`, which takes loops from all jobs at once
+    Nexus::ThreadPool pool(jobs - 1);
+    pool.run(inputs.size(), convert);
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << converted << "/" << inputs.size() << " robots, " << links << " links in "
+              << seconds << " s on " << jobs << " threads\n"
+              << "  Robots          " << converted / seconds << " /s\n"
+              << "  Links           " << links / seconds << " /s\n"
+              << "  Written         " << bytes / 1e6 << " MB, meshes in " << Nexus::MeshCache::Directory().string() << "\n";
+
+    return converted == inputs.size() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file